@@ -0,0 +1,7 @@
+#ifndef VERSION_H
+#define VERSION_H
+
+#define GIT_BRANCH "master"
+#define GIT_COMMIT_HASH "540d0a11f9a6b2cfbba8d8dd88451eb3d4bfaade"
+
+#endif
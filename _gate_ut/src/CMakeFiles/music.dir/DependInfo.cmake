@@ -0,0 +1,51 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/HydroinfoMUSIC.cpp" "src/CMakeFiles/music.dir/HydroinfoMUSIC.cpp.o" "gcc" "src/CMakeFiles/music.dir/HydroinfoMUSIC.cpp.o.d"
+  "/root/repo/src/advance.cpp" "src/CMakeFiles/music.dir/advance.cpp.o" "gcc" "src/CMakeFiles/music.dir/advance.cpp.o.d"
+  "/root/repo/src/cell.cpp" "src/CMakeFiles/music.dir/cell.cpp.o" "gcc" "src/CMakeFiles/music.dir/cell.cpp.o.d"
+  "/root/repo/src/cornelius.cpp" "src/CMakeFiles/music.dir/cornelius.cpp.o" "gcc" "src/CMakeFiles/music.dir/cornelius.cpp.o.d"
+  "/root/repo/src/dissipative.cpp" "src/CMakeFiles/music.dir/dissipative.cpp.o" "gcc" "src/CMakeFiles/music.dir/dissipative.cpp.o.d"
+  "/root/repo/src/emoji.cpp" "src/CMakeFiles/music.dir/emoji.cpp.o" "gcc" "src/CMakeFiles/music.dir/emoji.cpp.o.d"
+  "/root/repo/src/eos.cpp" "src/CMakeFiles/music.dir/eos.cpp.o" "gcc" "src/CMakeFiles/music.dir/eos.cpp.o.d"
+  "/root/repo/src/eos_EOSQ.cpp" "src/CMakeFiles/music.dir/eos_EOSQ.cpp.o" "gcc" "src/CMakeFiles/music.dir/eos_EOSQ.cpp.o.d"
+  "/root/repo/src/eos_UH.cpp" "src/CMakeFiles/music.dir/eos_UH.cpp.o" "gcc" "src/CMakeFiles/music.dir/eos_UH.cpp.o.d"
+  "/root/repo/src/eos_WB.cpp" "src/CMakeFiles/music.dir/eos_WB.cpp.o" "gcc" "src/CMakeFiles/music.dir/eos_WB.cpp.o.d"
+  "/root/repo/src/eos_base.cpp" "src/CMakeFiles/music.dir/eos_base.cpp.o" "gcc" "src/CMakeFiles/music.dir/eos_base.cpp.o.d"
+  "/root/repo/src/eos_best.cpp" "src/CMakeFiles/music.dir/eos_best.cpp.o" "gcc" "src/CMakeFiles/music.dir/eos_best.cpp.o.d"
+  "/root/repo/src/eos_hotQCD.cpp" "src/CMakeFiles/music.dir/eos_hotQCD.cpp.o" "gcc" "src/CMakeFiles/music.dir/eos_hotQCD.cpp.o.d"
+  "/root/repo/src/eos_idealgas.cpp" "src/CMakeFiles/music.dir/eos_idealgas.cpp.o" "gcc" "src/CMakeFiles/music.dir/eos_idealgas.cpp.o.d"
+  "/root/repo/src/eos_neos.cpp" "src/CMakeFiles/music.dir/eos_neos.cpp.o" "gcc" "src/CMakeFiles/music.dir/eos_neos.cpp.o.d"
+  "/root/repo/src/eos_s95p.cpp" "src/CMakeFiles/music.dir/eos_s95p.cpp.o" "gcc" "src/CMakeFiles/music.dir/eos_s95p.cpp.o.d"
+  "/root/repo/src/eta_domain.cpp" "src/CMakeFiles/music.dir/eta_domain.cpp.o" "gcc" "src/CMakeFiles/music.dir/eta_domain.cpp.o.d"
+  "/root/repo/src/evolve.cpp" "src/CMakeFiles/music.dir/evolve.cpp.o" "gcc" "src/CMakeFiles/music.dir/evolve.cpp.o.d"
+  "/root/repo/src/grid_info.cpp" "src/CMakeFiles/music.dir/grid_info.cpp.o" "gcc" "src/CMakeFiles/music.dir/grid_info.cpp.o.d"
+  "/root/repo/src/hydro_source_TATB.cpp" "src/CMakeFiles/music.dir/hydro_source_TATB.cpp.o" "gcc" "src/CMakeFiles/music.dir/hydro_source_TATB.cpp.o.d"
+  "/root/repo/src/hydro_source_ampt.cpp" "src/CMakeFiles/music.dir/hydro_source_ampt.cpp.o" "gcc" "src/CMakeFiles/music.dir/hydro_source_ampt.cpp.o.d"
+  "/root/repo/src/hydro_source_base.cpp" "src/CMakeFiles/music.dir/hydro_source_base.cpp.o" "gcc" "src/CMakeFiles/music.dir/hydro_source_base.cpp.o.d"
+  "/root/repo/src/hydro_source_strings.cpp" "src/CMakeFiles/music.dir/hydro_source_strings.cpp.o" "gcc" "src/CMakeFiles/music.dir/hydro_source_strings.cpp.o.d"
+  "/root/repo/src/init.cpp" "src/CMakeFiles/music.dir/init.cpp.o" "gcc" "src/CMakeFiles/music.dir/init.cpp.o.d"
+  "/root/repo/src/minmod.cpp" "src/CMakeFiles/music.dir/minmod.cpp.o" "gcc" "src/CMakeFiles/music.dir/minmod.cpp.o.d"
+  "/root/repo/src/music.cpp" "src/CMakeFiles/music.dir/music.cpp.o" "gcc" "src/CMakeFiles/music.dir/music.cpp.o.d"
+  "/root/repo/src/music_logo.cpp" "src/CMakeFiles/music.dir/music_logo.cpp.o" "gcc" "src/CMakeFiles/music.dir/music_logo.cpp.o.d"
+  "/root/repo/src/pretty_ostream.cpp" "src/CMakeFiles/music.dir/pretty_ostream.cpp.o" "gcc" "src/CMakeFiles/music.dir/pretty_ostream.cpp.o.d"
+  "/root/repo/src/read_in_parameters.cpp" "src/CMakeFiles/music.dir/read_in_parameters.cpp.o" "gcc" "src/CMakeFiles/music.dir/read_in_parameters.cpp.o.d"
+  "/root/repo/src/reconst.cpp" "src/CMakeFiles/music.dir/reconst.cpp.o" "gcc" "src/CMakeFiles/music.dir/reconst.cpp.o.d"
+  "/root/repo/src/transport_coeffs.cpp" "src/CMakeFiles/music.dir/transport_coeffs.cpp.o" "gcc" "src/CMakeFiles/music.dir/transport_coeffs.cpp.o.d"
+  "/root/repo/src/u_derivative.cpp" "src/CMakeFiles/music.dir/u_derivative.cpp.o" "gcc" "src/CMakeFiles/music.dir/u_derivative.cpp.o.d"
+  "/root/repo/src/util.cpp" "src/CMakeFiles/music.dir/util.cpp.o" "gcc" "src/CMakeFiles/music.dir/util.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unittest_cell.e.dir/cell_unittest.cpp.o"
+  "CMakeFiles/unittest_cell.e.dir/cell_unittest.cpp.o.d"
+  "unittest_cell.e"
+  "unittest_cell.e.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unittest_cell.e.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
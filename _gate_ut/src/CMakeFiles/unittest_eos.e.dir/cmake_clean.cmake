@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unittest_eos.e.dir/eos_unittest.cpp.o"
+  "CMakeFiles/unittest_eos.e.dir/eos_unittest.cpp.o.d"
+  "unittest_eos.e"
+  "unittest_eos.e.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unittest_eos.e.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
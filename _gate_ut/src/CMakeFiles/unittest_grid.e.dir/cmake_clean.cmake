@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unittest_grid.e.dir/grid_unittest.cpp.o"
+  "CMakeFiles/unittest_grid.e.dir/grid_unittest.cpp.o.d"
+  "unittest_grid.e"
+  "unittest_grid.e.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unittest_grid.e.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
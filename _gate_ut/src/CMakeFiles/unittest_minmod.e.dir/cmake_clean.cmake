@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unittest_minmod.e.dir/minmod_unittest.cpp.o"
+  "CMakeFiles/unittest_minmod.e.dir/minmod_unittest.cpp.o.d"
+  "unittest_minmod.e"
+  "unittest_minmod.e.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unittest_minmod.e.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unittest_reconst.e.dir/reconst_unittest.cpp.o"
+  "CMakeFiles/unittest_reconst.e.dir/reconst_unittest.cpp.o.d"
+  "unittest_reconst.e"
+  "unittest_reconst.e.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unittest_reconst.e.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
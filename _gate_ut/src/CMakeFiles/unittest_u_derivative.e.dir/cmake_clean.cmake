@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unittest_u_derivative.e.dir/u_derivative_unittest.cpp.o"
+  "CMakeFiles/unittest_u_derivative.e.dir/u_derivative_unittest.cpp.o.d"
+  "unittest_u_derivative.e"
+  "unittest_u_derivative.e.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unittest_u_derivative.e.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
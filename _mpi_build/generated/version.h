@@ -0,0 +1,7 @@
+#ifndef VERSION_H
+#define VERSION_H
+
+#define GIT_BRANCH "master"
+#define GIT_COMMIT_HASH "7e990a4b29c84ef9e7b24d0a962118943cd5bb68"
+
+#endif
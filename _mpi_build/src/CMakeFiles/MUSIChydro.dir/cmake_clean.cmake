@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/MUSIChydro.dir/main.cpp.o"
+  "CMakeFiles/MUSIChydro.dir/main.cpp.o.d"
+  "MUSIChydro"
+  "MUSIChydro.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/MUSIChydro.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
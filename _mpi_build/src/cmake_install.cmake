@@ -0,0 +1,103 @@
+# Install script for directory: /root/repo/src
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/root/repo")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}/root/repo/libmusic.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}/root/repo/libmusic.so")
+    file(RPATH_CHECK
+         FILE "$ENV{DESTDIR}/root/repo/libmusic.so"
+         RPATH "/root/repo:/usr/lib/x86_64-linux-gnu/openmpi/lib")
+  endif()
+  list(APPEND CMAKE_ABSOLUTE_DESTINATION_FILES
+   "/root/repo/libmusic.so")
+  if(CMAKE_WARN_ON_ABSOLUTE_INSTALL_DESTINATION)
+    message(WARNING "ABSOLUTE path INSTALL DESTINATION : ${CMAKE_ABSOLUTE_DESTINATION_FILES}")
+  endif()
+  if(CMAKE_ERROR_ON_ABSOLUTE_INSTALL_DESTINATION)
+    message(FATAL_ERROR "ABSOLUTE path INSTALL DESTINATION forbidden (by caller): ${CMAKE_ABSOLUTE_DESTINATION_FILES}")
+  endif()
+  file(INSTALL DESTINATION "/root/repo" TYPE SHARED_LIBRARY FILES "/root/repo/_mpi_build/src/libmusic.so")
+  if(EXISTS "$ENV{DESTDIR}/root/repo/libmusic.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}/root/repo/libmusic.so")
+    file(RPATH_CHANGE
+         FILE "$ENV{DESTDIR}/root/repo/libmusic.so"
+         OLD_RPATH "/usr/lib/x86_64-linux-gnu/openmpi/lib:::::::::::"
+         NEW_RPATH "/root/repo:/usr/lib/x86_64-linux-gnu/openmpi/lib")
+    if(CMAKE_INSTALL_DO_STRIP)
+      execute_process(COMMAND "/usr/bin/strip" "$ENV{DESTDIR}/root/repo/libmusic.so")
+    endif()
+  endif()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}/root/repo/MUSIChydro" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}/root/repo/MUSIChydro")
+    file(RPATH_CHECK
+         FILE "$ENV{DESTDIR}/root/repo/MUSIChydro"
+         RPATH "/root/repo:/usr/lib/x86_64-linux-gnu/openmpi/lib")
+  endif()
+  list(APPEND CMAKE_ABSOLUTE_DESTINATION_FILES
+   "/root/repo/MUSIChydro")
+  if(CMAKE_WARN_ON_ABSOLUTE_INSTALL_DESTINATION)
+    message(WARNING "ABSOLUTE path INSTALL DESTINATION : ${CMAKE_ABSOLUTE_DESTINATION_FILES}")
+  endif()
+  if(CMAKE_ERROR_ON_ABSOLUTE_INSTALL_DESTINATION)
+    message(FATAL_ERROR "ABSOLUTE path INSTALL DESTINATION forbidden (by caller): ${CMAKE_ABSOLUTE_DESTINATION_FILES}")
+  endif()
+  file(INSTALL DESTINATION "/root/repo" TYPE EXECUTABLE FILES "/root/repo/_mpi_build/src/MUSIChydro")
+  if(EXISTS "$ENV{DESTDIR}/root/repo/MUSIChydro" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}/root/repo/MUSIChydro")
+    file(RPATH_CHANGE
+         FILE "$ENV{DESTDIR}/root/repo/MUSIChydro"
+         OLD_RPATH "/root/repo/_mpi_build/src:/usr/lib/x86_64-linux-gnu/openmpi/lib:"
+         NEW_RPATH "/root/repo:/usr/lib/x86_64-linux-gnu/openmpi/lib")
+    if(CMAKE_INSTALL_DO_STRIP)
+      execute_process(COMMAND "/usr/bin/strip" "$ENV{DESTDIR}/root/repo/MUSIChydro")
+    endif()
+  endif()
+endif()
+
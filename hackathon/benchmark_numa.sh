@@ -0,0 +1,20 @@
+#!/usr/bin/env bash
+# strong scaling of the medium benchmark across the sockets of one node
+# usage: ./benchmark_numa.sh [max_threads]
+
+max_threads=${1:-$(nproc)}
+
+command -v numactl > /dev/null && numactl --hardware
+export OMP_PLACES=cores
+
+for bind in close spread; do
+    export OMP_PROC_BIND=${bind}
+    threads=1
+    while [ ${threads} -le ${max_threads} ]; do
+        export OMP_NUM_THREADS=${threads}
+        echo "doing benchmark middle, ${threads} threads, OMP_PROC_BIND=${bind} ..."
+        /usr/bin/time -f "%e s" ./mpihydro benchmark/music_input_Gubser_middle \
+            > benchmark/middle_${bind}_${threads}.log
+        threads=$((threads*2))
+    done
+done
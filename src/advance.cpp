@@ -2,10 +2,15 @@
 
 #ifdef _OPENMP
     #include <omp.h>
+#else
+    #define omp_get_thread_num() 0
+    #define omp_get_max_threads() 1
 #endif
 
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <limits>
 #include <memory>
 
 #include "util.h"
@@ -21,12 +26,15 @@ using Util::map_2d_idx_to_1d;
 using Util::map_1d_idx_to_2d;
 using Util::hbarc;
 
-Advance::Advance(const EOS &eosIn, const InitData &DATA_in,
-                 std::shared_ptr<HydroSourceBase> hydro_source_ptr_in) :
+template <class Cell>
+AdvanceT<Cell>::AdvanceT(const EOS &eosIn, const InitData &DATA_in,
+                         std::shared_ptr<HydroSourceBase> hydro_source_ptr_in) :
     DATA(DATA_in), eos(eosIn),
     diss_helper(eosIn, DATA_in),
+    u_derivative_helpers(DATA_in, eosIn),
     minmod(DATA_in),
-    reconst_helper(eos, DATA_in.echo_level) {
+    reconst_helper(eos, DATA_in.echo_level),
+    pencil_scratch(omp_get_max_threads()) {
 
     hydro_source_terms_ptr = hydro_source_ptr_in;
     flag_add_hydro_source = false;
@@ -39,76 +47,276 @@ Advance::Advance(const EOS &eosIn, const InitData &DATA_in,
             flag_add_hydro_source = true;
         }
     }
+    select_physics_kernel();
+}
+
+//! picks the AdvanceItT instantiation for the viscous currents switched on
+//! in the input, so the per-cell loops carry no runtime physics checks
+template <class Cell>
+void AdvanceT<Cell>::select_physics_kernel() {
+    if (DATA.viscosity_flag == 0) {
+        advance_kernel = &AdvanceT::AdvanceItT<IdealPhysics>;
+        return;
+    }
+    const int flags = (  4*(DATA.turn_on_shear == 1)
+                       + 2*(DATA.turn_on_bulk == 1)
+                       +   (DATA.turn_on_diff == 1));
+    switch (flags) {
+        case 0:
+            advance_kernel = &AdvanceT::AdvanceItT<
+                                PhysicsConfig<true, false, false, false>>;
+            break;
+        case 1:
+            advance_kernel = &AdvanceT::AdvanceItT<
+                                PhysicsConfig<true, false, false, true>>;
+            break;
+        case 2:
+            advance_kernel = &AdvanceT::AdvanceItT<
+                                PhysicsConfig<true, false, true, false>>;
+            break;
+        case 3:
+            advance_kernel = &AdvanceT::AdvanceItT<
+                                PhysicsConfig<true, false, true, true>>;
+            break;
+        case 4:
+            advance_kernel = &AdvanceT::AdvanceItT<
+                                PhysicsConfig<true, true, false, false>>;
+            break;
+        case 5:
+            advance_kernel = &AdvanceT::AdvanceItT<
+                                PhysicsConfig<true, true, false, true>>;
+            break;
+        case 6:
+            advance_kernel = &AdvanceT::AdvanceItT<
+                                PhysicsConfig<true, true, true, false>>;
+            break;
+        default:
+            advance_kernel = &AdvanceT::AdvanceItT<
+                                PhysicsConfig<true, true, true, true>>;
+            break;
+    }
 }
 
 //! this function evolves one Runge-Kutta step in tau
-void Advance::AdvanceIt(const double tau,
-                        SCGrid &arena_prev, SCGrid &arena_current,
-                        SCGrid &arena_future, const int rk_flag) {
+template <class Cell>
+template <class Physics>
+void AdvanceT<Cell>::AdvanceItT(const double tau,
+                                Grid &arena_prev, Grid &arena_current,
+                                Grid &arena_future, const int rk_flag,
+                                const int ieta_begin, const int ieta_end) {
     const int grid_neta = arena_current.nEta();
     const int grid_nx   = arena_current.nX();
     const int grid_ny   = arena_current.nY();
 
-    #pragma omp parallel for collapse(3) schedule(guided)
-    for (int ieta = 0; ieta < grid_neta; ieta++)
-    for (int ix   = 0; ix   < grid_nx;   ix++  )
-    for (int iy   = 0; iy   < grid_ny;   iy++  ) {
-        double eta_s_local = - DATA.eta_size/2. + ieta*DATA.delta_eta;
-        double x_local     = - DATA.x_size  /2. +   ix*DATA.delta_x;
-        double y_local     = - DATA.y_size  /2. +   iy*DATA.delta_y;
+    // the stencils read the ghost layer of arena_current directly, two
+    // cells around the slab (all of the eta ghost layer at its ends)
+    arena_current.fill_ghost_cells(
+        ieta_begin > 0         ? ieta_begin - 2 : -arena_current.nGhost(),
+        ieta_end   < grid_neta ? ieta_end + 2
+                               : grid_neta + arena_current.nGhost());
+
+    SCGridSoA &current_soa = arena_current_soa;
+    if (DATA.use_SoA_grid_storage == 1) {
+        if (current_soa.size() != arena_current.size()) {
+            current_soa = SCGridSoA(grid_nx, grid_ny, grid_neta);
+        }
+        current_soa.copy_from(arena_current, ieta_begin - 2, ieta_end + 2);
+    }
+
+    GridBox box(grid_nx, grid_ny, grid_neta);
+    if (DATA.active_region_eps_cut > 0.) {
+        box = active_box;
+    }
+    box.lo[2] = std::max(box.lo[2], ieta_begin);
+    box.hi[2] = std::min(box.hi[2], ieta_end);
+    if (DATA.active_region_eps_cut > 0.) {
+        // the vacuum outside of the active box is carried over unchanged
+        #pragma omp parallel for collapse(2)
+        for (int ieta = ieta_begin; ieta < ieta_end; ieta++)
+        for (int iy   = 0; iy   < grid_ny;   iy++  )
+        for (int ix   = 0; ix   < grid_nx;   ix++  ) {
+            if (!box.contains(ix, iy, ieta)) {
+                arena_future(ix, iy, ieta) = arena_current(ix, iy, ieta);
+            }
+        }
+    }
+
+    const std::array<int, 3> brick = {DATA.brick_size_x, DATA.brick_size_y,
+                                      DATA.brick_size_eta};
+    const double tau_rk = tau + get_rk_stage(DATA.rk_order, rk_flag).c
+                                *DATA.delta_tau;
+    auto update_cell = [&](const int ix, const int iy, const int ieta,
+                           const TJbVec &qi) {
+        double eta_s_local = (- DATA.eta_size/2.
+                              + arena_current.ieta_input(ieta)*DATA.delta_eta);
+        double x_local     = (- DATA.x_size/2.
+                              + arena_current.ix_input(ix)*DATA.delta_x);
+        double y_local     = (- DATA.y_size/2.
+                              + arena_current.iy_input(iy)*DATA.delta_y);
+
+        FirstRKStepT<Physics>(tau, x_local, y_local, eta_s_local,
+                              arena_current, arena_future, arena_prev,
+                              ix, iy, ieta, rk_flag, qi);
+
+        AdvanceViscousCell<Physics>(
+                tau, arena_prev, arena_current, arena_future, rk_flag,
+                ix, iy, ieta,
+                std::integral_constant<bool, Physics::viscosity>());
+    };
+
+    // the stencils take tau*T^{tau mu} from the primitive cache if it is
+    // on, and the cell values (reconstruction guesses) from the SoA copy
+    if (DATA.use_primitive_cache == 1) {
+        auto &cache = thermo_cache[std::min(rk_flag, 1)];
+        FillThermoCache<Physics>(tau_rk, arena_current, box, cache);
+        if (DATA.use_SoA_grid_storage == 1) {
+            FluxSweep(tau_rk, current_soa, cache, box, brick, rk_flag,
+                      update_cell);
+        } else {
+            FluxSweep(tau_rk, arena_current, cache, box, brick, rk_flag,
+                      update_cell);
+        }
+    } else if (DATA.use_SoA_grid_storage == 1) {
+        FluxSweep(tau_rk, current_soa, current_soa, box, brick,
+                  rk_flag, update_cell);
+    } else {
+        FluxSweep(tau_rk, arena_current, arena_current, box, brick,
+                  rk_flag, update_cell);
+    }
+}
+
 
-        FirstRKStepT(tau, x_local, y_local, eta_s_local,
-                     arena_current, arena_future, arena_prev,
-                     ix, iy, ieta, rk_flag);
+//! computes qi of every cell of box with the selected flux kernel and
+//! hands it to update_cell(ix, iy, ieta, qi)
+template <class Cell>
+template <class GridType, class QGridType, class Func>
+void AdvanceT<Cell>::FluxSweep(const double tau_rk,
+                               const GridType &arena_current,
+                               const QGridType &q_grid, const GridBox &box,
+                               const std::array<int, 3> &brick,
+                               const int rk_flag, Func update_cell) {
+    if (DATA.use_face_flux_kernel == 1) {
+        MakeFaceFluxes(tau_rk, arena_current, q_grid, box, brick);
+        Brickloop(box, brick, [&](const int ix, const int iy,
+                                  const int ieta) {
+            TJbVec qi = {0};
+            DeltaQIFromFaces(tau_rk, arena_current, q_grid, ix, iy, ieta, qi);
+            update_cell(ix, iy, ieta, qi);
+        });
+    } else if (DATA.use_pencil_flux_kernel == 1) {
+        Pencilloop(box, brick, [&](const int ix_begin, const int ix_end,
+                                   const int iy, const int ieta) {
+            std::vector<TJbVec> &qi = pencil_scratch[omp_get_thread_num()].qi;
+            qi.resize(ix_end - ix_begin);
+            MakeDeltaQIPencil(tau_rk, arena_current, q_grid, ix_begin, ix_end,
+                              iy, ieta, qi.data(), rk_flag);
+            for (int ix = ix_begin; ix < ix_end; ix++) {
+                update_cell(ix, iy, ieta, qi[ix - ix_begin]);
+            }
+        });
+    } else {
+        Brickloop(box, brick, [&](const int ix, const int iy,
+                                  const int ieta) {
+            TJbVec qi = {0};
+            MakeDeltaQI(tau_rk, arena_current, q_grid, ix, iy, ieta, qi,
+                        rk_flag);
+            update_cell(ix, iy, ieta, qi);
+        });
+    }
+}
+
+
+//! fills cache with the thermodynamics of the cells of arena_current in
+//! box and the two cells around it that the stencils read
+template <class Cell>
+template <class Physics>
+void AdvanceT<Cell>::FillThermoCache(const double tau_rk,
+                                     const Grid &arena_current,
+                                     const GridBox &box,
+                                     GridT<CellThermo> &cache) {
+    const int nx   = arena_current.nX();
+    const int ny   = arena_current.nY();
+    const int neta = arena_current.nEta();
+    if (cache.nX() != nx || cache.nY() != ny || cache.nEta() != neta) {
+        cache = GridT<CellThermo>(nx, ny, neta);
+    }
+    GridBox halo_box = box;
+    const std::array<int, 3> n = {{nx, ny, neta}};
+    for (int i = 0; i < 3; i++) {
+        halo_box.lo[i] = std::max(0, box.lo[i] - 2);
+        halo_box.hi[i] = std::min(n[i], box.hi[i] + 2);
+    }
+    const std::array<int, 3> brick = {DATA.brick_size_x, DATA.brick_size_y,
+                                      DATA.brick_size_eta};
+    Brickloop(halo_box, brick, [&](const int ix, const int iy,
+                                   const int ieta) {
+        cache(ix, iy, ieta) = get_thermo<Physics::viscosity>(
+                                    arena_current(ix, iy, ieta), tau_rk);
+    });
+}
 
-        if (DATA.viscosity_flag == 1) {
-            U_derivative u_derivative_helper(DATA, eos);
-            u_derivative_helper.MakedU(tau, arena_prev, arena_current,
-                                       ix, iy, ieta);
-            double theta_local = u_derivative_helper.calculate_expansion_rate(
-                                            tau, arena_current, ieta, ix, iy);
-            DumuVec a_local;
-            u_derivative_helper.calculate_Du_supmu(tau, arena_current,
-                                                   ieta, ix, iy, a_local);
 
-            VelocityShearVec sigma_local;
-            u_derivative_helper.calculate_velocity_shear_tensor(
-                    tau, arena_current, ieta, ix, iy, a_local, sigma_local);
+template <class Cell>
+template <class Physics>
+void AdvanceT<Cell>::AdvanceViscousCell(
+        const double tau, Grid &arena_prev, Grid &arena_current,
+        Grid &arena_future, const int rk_flag,
+        const int ix, const int iy, const int ieta, std::true_type) {
+    ViscousGradients grad;
+    const DerivedFields *fields = (
+        (rk_flag == 0 && first_stage_fields != nullptr)
+        ? first_stage_fields->find(ix, iy, ieta) : nullptr);
+    if (fields != nullptr) {
+        grad = fields->grad;
+    } else {
+        u_derivative_helpers.local().compute_viscous_gradients(
+                tau, arena_prev, arena_current, ix, iy, ieta, grad);
+    }
 
-            VorticityVec omega_local;
-            u_derivative_helper.calculate_kinetic_vorticity_with_spatial_projector(
-                    tau, arena_current, ieta, ix, iy, a_local, omega_local);
+    FirstRKStepW<Physics>(
+            tau, arena_prev, arena_current, arena_future, rk_flag,
+            grad.theta, grad.a, grad.sigma, grad.omega, grad.DmuMuBoverT,
+            ieta, ix, iy);
+}
 
-            DmuMuBoverTVec baryon_diffusion_vector;
-            u_derivative_helper.get_DmuMuBoverTVec(baryon_diffusion_vector);
 
-            FirstRKStepW(tau, arena_prev, arena_current, arena_future, rk_flag,
-                         theta_local, a_local, sigma_local, omega_local,
-                         baryon_diffusion_vector, ieta, ix, iy);
-        }
+template <class Cell>
+template <class Physics>
+void AdvanceT<Cell>::MakeWSource(
+        const double tau_rk, const Grid &arena_current, const Grid &arena_prev,
+        const int ix, const int iy, const int ieta, TJbVec &dwmn,
+        std::true_type) {
+    if (DATA.use_SoA_grid_storage == 1) {
+        diss_helper.MakeWSource<Physics::bulk>(
+            tau_rk, arena_current_soa, arena_prev, ix, iy, ieta, dwmn);
+    } else {
+        diss_helper.MakeWSource<Physics::bulk>(
+            tau_rk, arena_current, arena_prev, ix, iy, ieta, dwmn);
     }
 }
 
 
 /* %%%%%%%%%%%%%%%%%%%%%% First steps begins here %%%%%%%%%%%%%%%%%% */
-void Advance::FirstRKStepT(
+template <class Cell>
+template <class Physics>
+void AdvanceT<Cell>::FirstRKStepT(
         const double tau, const double x_local, const double y_local,
         const double eta_s_local,
-        SCGrid &arena_current, SCGrid &arena_future, SCGrid &arena_prev,
-        const int ix, const int iy, const int ieta, const int rk_flag) {
+        Grid &arena_current, Grid &arena_future, Grid &arena_prev,
+        const int ix, const int iy, const int ieta, const int rk_flag,
+        TJbVec qi) {
     // this advances the ideal part
-    double tau_rk = tau + rk_flag*(DATA.delta_tau);
+    const RKStage stage = get_rk_stage(DATA.rk_order, rk_flag);
+    double tau_rk = tau + stage.c*(DATA.delta_tau);
 
     // Solve partial_a T^{a mu} = -partial_a W^{a mu}
     // Update T^{mu nu}
-    // MakeDelatQI gets
+    // qi comes from MakeDeltaQI (or MakeDeltaQIPencil):
     //   qi = q0 if rk_flag = 0 or
-    //   qi = q0 + k1 if rk_flag = 1
-    // rhs[alpha] is what MakeDeltaQI outputs. 
-    // It is the spatial derivative part of partial_a T^{a mu}
+    //   qi = q0 + k1 (q0 + k1 + k2 for rk_order 3) if rk_flag > 0
+    // plus rhs[alpha], the spatial derivative part of partial_a T^{a mu}
     // (including geometric terms)
-    TJbVec qi = {0};
-    MakeDeltaQI(tau_rk, arena_current, ix, iy, ieta, qi, rk_flag);
+    const double a_over_b = stage.a/stage.b;
 
     TJbVec qi_source = {0.0};
 
@@ -136,9 +344,11 @@ void Advance::FirstRKStepT(
 
     // now MakeWSource returns partial_a W^{a mu}
     // (including geometric terms)
+    // (ideal hydrodynamics carries no W^{mu nu})
     TJbVec dwmn ={0.0};
-    diss_helper.MakeWSource(tau_rk, arena_current, arena_prev, ix, iy, ieta,
-                            dwmn);
+    MakeWSource<Physics>(
+            tau_rk, arena_current, arena_prev, ix, iy, ieta, dwmn,
+            std::integral_constant<bool, Physics::viscosity>());
     for (int alpha = 0; alpha < 5; alpha++) {
         /* dwmn is the only one with the minus sign */
         qi[alpha] -= dwmn[alpha]*(DATA.delta_tau);
@@ -156,32 +366,56 @@ void Advance::FirstRKStepT(
         //}
 
         /* if rk_flag > 0, we now have q0 + k1 + k2. 
-         * So add q0 and multiply by 1/2 */
-        qi[alpha] += rk_flag*get_TJb(arena_prev(ix,iy,ieta), alpha, 0)*tau;
-        qi[alpha] *= 1./(1. + rk_flag);
+         * So add a/b q0 and multiply by b (1/2 for rk_order 2) */
+        qi[alpha] += a_over_b*get_TJb(arena_prev(ix,iy,ieta), alpha, 0)*tau;
+        qi[alpha] *= stage.b;
     }
 
-    double tau_next = tau + DATA.delta_tau;
+    double tau_next = tau + stage.c_out*DATA.delta_tau;
     auto grid_rk_t = reconst_helper.ReconstIt_shell(
                                 tau_next, qi, arena_current(ix, iy, ieta)); 
     UpdateTJbRK(grid_rk_t, arena_future(ix, iy, ieta));
 }
 
 
-void Advance::FirstRKStepW(const double tau, SCGrid &arena_prev,
-                           SCGrid &arena_current, SCGrid &arena_future,
-                           const int rk_flag, const double theta_local,
-                           const DumuVec &a_local,
-                           const VelocityShearVec &sigma_local,
-                           const VorticityVec &omega_local,
-                           const DmuMuBoverTVec &baryon_diffusion_vector,
-                           const int ieta, const int ix, const int iy) {
+template <class Cell>
+template <class Physics>
+void AdvanceT<Cell>::FirstRKStepW(const double tau, Grid &arena_prev,
+                                  Grid &arena_current, Grid &arena_future,
+                                  const int rk_flag, const double theta_local,
+                                  const DumuVec &a_local,
+                                  const VelocityShearVec &sigma_local,
+                                  const VorticityVec &omega_local,
+                                  const DmuMuBoverTVec &baryon_diffusion_vector,
+                                  const int ieta, const int ix, const int iy) {
 
     auto grid_pt_prev = &(arena_prev(ix, iy, ieta));
     auto grid_pt_c = &(arena_current(ix, iy, ieta));
     auto grid_pt_f = &(arena_future(ix, iy, ieta));
 
-    const double tau_now  = tau + rk_flag*DATA.delta_tau;
+    const RKStage stage   = get_rk_stage(DATA.rk_order, rk_flag);
+    const double tau_now  = tau + stage.c*DATA.delta_tau;
+    // b*(u^n*a/b + dtau*L(u) + u): the first stage starts from u, the
+    // later ones from u^n = arena_prev
+    const double a_over_b    = stage.a/stage.b;
+    const double later_stage = (rk_flag == 0) ? 0. : 1.;
+
+    // the source terms take the thermodynamics of the current cell at the
+    // first stage and of u^n = arena_prev at the later ones; the cache of
+    // the first stage holds exactly those
+    const CellThermo thermo = (
+        (DATA.use_primitive_cache == 1)
+        ? thermo_cache[0](ix, iy, ieta)
+        : get_thermo<true>((rk_flag == 0) ? *grid_pt_c : *grid_pt_prev,
+                           tau_now));
+
+    // with semi_implicit_relaxation the source terms leave out the
+    // relaxation term -X/tau_X, which is taken at the end of the stage:
+    // u^0 X_f + b*dtau*X_f/tau_X = tempf
+    double rate = 0.;
+    double *relaxation_rate = (
+        (DATA.semi_implicit_relaxation == 1) ? &rate : nullptr);
+    const double b_dtau = stage.b*DATA.delta_tau;
 
     // Solve partial_a (u^a W^{mu nu}) = 0
     // Update W^{mu nu}
@@ -193,7 +427,7 @@ void Advance::FirstRKStepW(const double tau, SCGrid &arena_prev,
     // solve partial_tau (u^0 W^{kl}) = -partial_i (u^i W^{kl}
     /* Advance uWmunu */
     double tempf, temps;
-    if (DATA.turn_on_shear == 1) {
+    if (Physics::shear) {
         for (int idx_1d = 4; idx_1d < 9; idx_1d++) {
             double w_rhs = 0.;
             int mu = 0;
@@ -202,17 +436,18 @@ void Advance::FirstRKStepW(const double tau, SCGrid &arena_prev,
             diss_helper.Make_uWRHS(tau_now, arena_current, ix, iy, ieta,
                                    mu, nu, w_rhs, theta_local, a_local);
             tempf = (
-                  (1. - rk_flag)*(grid_pt_c->Wmunu[idx_1d]*grid_pt_c->u[0])
-                + rk_flag*(grid_pt_prev->Wmunu[idx_1d]*grid_pt_prev->u[0])
+                  (1. - later_stage)*(grid_pt_c->Wmunu[idx_1d]*grid_pt_c->u[0])
+                + a_over_b*(grid_pt_prev->Wmunu[idx_1d]*grid_pt_prev->u[0])
             );
             temps = diss_helper.Make_uWSource(
-                    tau_now, grid_pt_c, grid_pt_prev, mu, nu, rk_flag,
-                    theta_local, a_local, sigma_local, omega_local);
+                    tau_now, grid_pt_c, grid_pt_prev, thermo, mu, nu, rk_flag,
+                    theta_local, a_local, sigma_local, omega_local,
+                    relaxation_rate);
             tempf += temps*(DATA.delta_tau);
             tempf += w_rhs;
-            tempf += rk_flag*((grid_pt_c->Wmunu[idx_1d])*(grid_pt_c->u[0]));
-            tempf *= 1./(1. + rk_flag);
-            grid_pt_f->Wmunu[idx_1d] = tempf/(grid_pt_f->u[0]);
+            tempf += later_stage*((grid_pt_c->Wmunu[idx_1d])*(grid_pt_c->u[0]));
+            tempf *= stage.b;
+            grid_pt_f->Wmunu[idx_1d] = tempf/(grid_pt_f->u[0] + b_dtau*rate);
         }
     } else {
         for (int idx_1d = 4; idx_1d < 9; idx_1d++) {
@@ -220,44 +455,45 @@ void Advance::FirstRKStepW(const double tau, SCGrid &arena_prev,
         }
     }
 
-    if (DATA.turn_on_bulk == 1) {
+    if (Physics::bulk) {
         double p_rhs;
         diss_helper.Make_uPRHS(tau_now, arena_current, ix, iy, ieta,
                                &p_rhs, theta_local);
-        tempf = ((1. - rk_flag)*(grid_pt_c->pi_b*grid_pt_c->u[0])
-                 + rk_flag*(grid_pt_prev->pi_b*grid_pt_prev->u[0]));
+        tempf = ((1. - later_stage)*(grid_pt_c->pi_b*grid_pt_c->u[0])
+                 + a_over_b*(grid_pt_prev->pi_b*grid_pt_prev->u[0]));
         temps = diss_helper.Make_uPiSource(
-                tau_now, grid_pt_c, grid_pt_prev, rk_flag,
-                theta_local, sigma_local);
+                tau_now, grid_pt_c, grid_pt_prev, thermo, rk_flag,
+                theta_local, sigma_local, relaxation_rate);
         tempf += temps*(DATA.delta_tau);
         tempf += p_rhs;
-        tempf += rk_flag*((grid_pt_c->pi_b)*(grid_pt_c->u[0]));
-        tempf *= 1./(1. + rk_flag);
-        grid_pt_f->pi_b = tempf/(grid_pt_f->u[0]);
+        tempf += later_stage*((grid_pt_c->pi_b)*(grid_pt_c->u[0]));
+        tempf *= stage.b;
+        grid_pt_f->pi_b = tempf/(grid_pt_f->u[0] + b_dtau*rate);
     } else {
         grid_pt_f->pi_b = 0.0;
     }
 
     // CShen: add source term for baryon diffusion
-    if (DATA.turn_on_diff == 1) {
+    if (Physics::diff) {
         int mu = 4;
         for (int idx_1d = 11; idx_1d < 14; idx_1d++) {
             int nu = idx_1d - 10;
             double w_rhs = diss_helper.Make_uqRHS(
                         tau_now, arena_current, ix, iy, ieta, mu, nu);
-            tempf = ((1. - rk_flag)*(grid_pt_c->Wmunu[idx_1d]*grid_pt_c->u[0])
-                     + rk_flag*(grid_pt_prev->Wmunu[idx_1d]*grid_pt_prev->u[0]));
+            tempf = (
+                  (1. - later_stage)*(grid_pt_c->Wmunu[idx_1d]*grid_pt_c->u[0])
+                + a_over_b*(grid_pt_prev->Wmunu[idx_1d]*grid_pt_prev->u[0]));
             temps = diss_helper.Make_uqSource(
-                        tau_now, grid_pt_c, grid_pt_prev, nu, rk_flag,
+                        tau_now, grid_pt_c, grid_pt_prev, thermo, nu, rk_flag,
                         theta_local, a_local, sigma_local, omega_local,
-                        baryon_diffusion_vector);
+                        baryon_diffusion_vector, relaxation_rate);
             tempf += temps*(DATA.delta_tau);
             tempf += w_rhs;
 
-            tempf += rk_flag*(grid_pt_c->Wmunu[idx_1d]*grid_pt_c->u[0]);
-            tempf *= 1./(1. + rk_flag);
+            tempf += later_stage*(grid_pt_c->Wmunu[idx_1d]*grid_pt_c->u[0]);
+            tempf *= stage.b;
 
-            grid_pt_f->Wmunu[idx_1d] = tempf/(grid_pt_f->u[0]);
+            grid_pt_f->Wmunu[idx_1d] = tempf/(grid_pt_f->u[0] + b_dtau*rate);
         }
     } else {
         for (int idx_1d = 10; idx_1d < 14; idx_1d++) {
@@ -298,20 +534,21 @@ void Advance::FirstRKStepW(const double tau, SCGrid &arena_prev,
         int idx_1d = map_2d_idx_to_1d(4, nu);
         tempf += grid_pt_f->Wmunu[idx_1d]*grid_pt_f->u[nu];
     }
-    grid_pt_f->Wmunu[10] = DATA.turn_on_diff*tempf/(grid_pt_f->u[0]);
+    grid_pt_f->Wmunu[10] = Physics::diff ? tempf/(grid_pt_f->u[0]) : 0.0;
 
     // If the energy density of the fluid element is smaller than 0.01GeV
     // reduce Wmunu using the QuestRevert algorithm
     if (DATA.Initial_profile != 0 && DATA.Initial_profile != 1) {
         QuestRevert(tau, grid_pt_f, ieta, ix, iy);
-        if (DATA.turn_on_diff == 1) {
+        if (Physics::diff) {
             QuestRevert_qmu(tau, grid_pt_f, ieta, ix, iy);
         }
     }
 }
 
 // update results after RK evolution to grid_pt
-void Advance::UpdateTJbRK(const ReconstCell &grid_rk, Cell_small &grid_pt) {
+template <class Cell>
+void AdvanceT<Cell>::UpdateTJbRK(const ReconstCell &grid_rk, Cell &grid_pt) {
     grid_pt.epsilon = grid_rk.e;
     grid_pt.rhob    = grid_rk.rhob;
     grid_pt.u       = grid_rk.u;
@@ -320,8 +557,9 @@ void Advance::UpdateTJbRK(const ReconstCell &grid_rk, Cell_small &grid_pt) {
 
 //! this function reduce the size of shear stress tensor and bulk pressure
 //! in the dilute region to stablize numerical simulations
-void Advance::QuestRevert(const double tau, Cell_small *grid_pt,
-                          const int ieta, const int ix, const int iy) {
+template <class Cell>
+void AdvanceT<Cell>::QuestRevert(const double tau, Cell_small *grid_pt,
+                                 const int ieta, const int ix, const int iy) {
     double eps_scale = 0.1;   // 1/fm^4
     double e_local   = grid_pt->epsilon;
     double rhob      = grid_pt->rhob;
@@ -397,8 +635,9 @@ void Advance::QuestRevert(const double tau, Cell_small *grid_pt,
 
 //! this function reduce the size of net baryon diffusion current
 //! in the dilute region to stablize numerical simulations
-void Advance::QuestRevert_qmu(const double tau, Cell_small *grid_pt,
-                              const int ieta, const int ix, const int iy) {
+template <class Cell>
+void AdvanceT<Cell>::QuestRevert_qmu(const double tau, Cell_small *grid_pt,
+                                     const int ieta, const int ix, const int iy) {
     double eps_scale = 0.1;   // in 1/fm^4
 
     double xi = 0.05;
@@ -457,15 +696,21 @@ void Advance::QuestRevert_qmu(const double tau, Cell_small *grid_pt,
 
 //! This function computes the rhs array. It computes the spatial
 //! derivatives of T^\mu\nu using the KT algorithm
-void Advance::MakeDeltaQI(const double tau, SCGrid &arena_current,
-                          const int ix, const int iy, const int ieta,
-                          TJbVec &qi, const int rk_flag) {
-    const double delta[4]   = {0.0, DATA.delta_x, DATA.delta_y, DATA.delta_eta};
-    const double tau_fac[4] = {0.0, tau, tau, 1.0};
+//! GridType is either Grid or its structure-of-arrays copy SCGridSoA;
+//! tau*T^{tau alpha} of the stencil comes from q_grid, which is either
+//! arena_current itself or the primitive cache
+template <class Cell>
+template <class GridType, class QGridType>
+void AdvanceT<Cell>::MakeDeltaQI(const double tau, const GridType &arena_current,
+                                 const QGridType &q_grid,
+                                 const int ix, const int iy, const int ieta,
+                                 TJbVec &qi, const int rk_flag) {
+    typedef typename QGridType::cell_view CellView;
 
     for (int alpha = 0; alpha < 5; alpha++) {
-        qi[alpha] = get_TJb(arena_current(ix, iy, ieta), alpha, 0)*tau;
+        qi[alpha] = get_tauTJb0(q_grid(ix, iy, ieta), alpha, tau);
     }
+    const auto &c_guess = arena_current(ix, iy, ieta);
 
     TJbVec qiphL   = {0.};
     TJbVec qiphR   = {0.};
@@ -475,17 +720,18 @@ void Advance::MakeDeltaQI(const double tau, SCGrid &arena_current,
     TJbVec rhs     = {0.};
     EnergyFlowVec T_eta_m = {0.};
     EnergyFlowVec T_eta_p = {0.};
-    Neighbourloop(arena_current, ix, iy, ieta, NLAMBDAS{
+    const int n_direc = DATA.boost_invariant ? 2 : 3;
+    Neighbourloop(q_grid, ix, iy, ieta, NLAMBDAS_VIEW(CellView){
         for (int alpha = 0; alpha < 5; alpha++) {
             const double gphL = qi[alpha];
-            const double gphR = tau*get_TJb(p1, alpha, 0);
-            const double gmhL = tau*get_TJb(m1, alpha, 0);
+            const double gphR = get_tauTJb0(p1, alpha, tau);
+            const double gmhL = get_tauTJb0(m1, alpha, tau);
             const double gmhR = qi[alpha];
             const double fphL =  0.5*minmod.minmod_dx(gphR, qi[alpha], gmhL);
             const double fphR = -0.5*minmod.minmod_dx(
-                                tau*get_TJb(p2, alpha, 0), gphR, qi[alpha]);
+                                get_tauTJb0(p2, alpha, tau), gphR, qi[alpha]);
             const double fmhL =  0.5*minmod.minmod_dx(
-                                qi[alpha], gmhL, tau*get_TJb(m2, alpha, 0));
+                                qi[alpha], gmhL, get_tauTJb0(m2, alpha, tau));
             const double fmhR = -fphL;
             qiphL[alpha] = gphL + fphL;
             qiphR[alpha] = gphR + fphR;
@@ -493,46 +739,360 @@ void Advance::MakeDeltaQI(const double tau, SCGrid &arena_current,
             qimhR[alpha] = gmhR + fmhR;
         }
 
-        // for each direction, reconstruct half-way cells
-        // reconstruct e, rhob, and u[4] for half way cells
-        auto grid_phL = reconst_helper.ReconstIt_shell(tau, qiphL, c);
-        auto grid_phR = reconst_helper.ReconstIt_shell(tau, qiphR, c);
-        auto grid_mhL = reconst_helper.ReconstIt_shell(tau, qimhL, c);
-        auto grid_mhR = reconst_helper.ReconstIt_shell(tau, qimhR, c);
+        KTFluxes(tau, direction, c_guess, qiphL, qiphR, qimhL, qimhR,
+                 rhs, T_eta_m, T_eta_p);
+    }, n_direc);
+    if (DATA.boost_invariant) {
+        BoostInvariantEtaFluxes(tau, qi, c_guess, T_eta_m, T_eta_p);
+    }
+
+    AddEtaFluxes(T_eta_m, T_eta_p, rhs);
+
+    for (int i = 0; i < 5; i++) {
+        qi[i] += rhs[i];
+    }
+}
+
+//! Pencil variant of MakeDeltaQI: computes qi of the n = ix_end - ix_begin
+//! cells (ix_begin <= ix < ix_end, iy, ieta) together. tau*T^{tau alpha}
+//! of the pencil and of its neighbour rows is evaluated once per row, and
+//! the minmod slopes and half-way states are computed by loops over the
+//! pencil that vectorize. The reconstruction and the KT fluxes then follow
+//! MakeDeltaQI operation by operation, so both give identical results.
+template <class Cell>
+template <class GridType, class QGridType>
+void AdvanceT<Cell>::MakeDeltaQIPencil(const double tau,
+                                       const GridType &arena_current,
+                                       const QGridType &q_grid,
+                                       const int ix_begin, const int ix_end,
+                                       const int iy, const int ieta,
+                                       TJbVec *qi, const int rk_flag) {
+    const int n  = ix_end - ix_begin;
+    const int nh = n + 4;  // row length including the +-2 halo along x
+
+    // q[(irow*5 + alpha)*nh + 2 + i] is tau*T^{tau alpha} of cell
+    // ix_begin + i of row irow: 0 is the pencil itself (with halo), 1 to 4
+    // are the rows at -2, -1, +1, +2 along the transverse direction
+    PencilScratch &scratch = pencil_scratch[omp_get_thread_num()];
+    std::vector<double> &q = scratch.q;
+    q.resize(5*5*nh);
+    auto fill_row = [&](const int irow, const int diy, const int dieta,
+                        const int i_begin, const int i_end) {
+        for (int i = i_begin; i < i_end; i++) {
+            const auto &cell = q_grid.getHalo(ix_begin + i, iy + diy,
+                                              ieta + dieta);
+            for (int alpha = 0; alpha < 5; alpha++) {
+                q[(irow*5 + alpha)*nh + 2 + i] = get_tauTJb0(cell, alpha, tau);
+            }
+        }
+    };
+    auto row = [&](const int irow, const int alpha) {
+        return(&q[(irow*5 + alpha)*nh + 2]);
+    };
+    fill_row(0, 0, 0, -2, n + 2);
+
+    std::vector<double> &slope = scratch.slope;
+    std::vector<double> &qphL = scratch.qphL, &qphR = scratch.qphR;
+    std::vector<double> &qmhL = scratch.qmhL, &qmhR = scratch.qmhR;
+    std::vector<TJbVec> &rhs = scratch.rhs;
+    std::vector<EnergyFlowVec> &T_eta_m = scratch.T_eta_m;
+    std::vector<EnergyFlowVec> &T_eta_p = scratch.T_eta_p;
+    slope.resize(n);
+    qphL.resize(5*n); qphR.resize(5*n); qmhL.resize(5*n); qmhR.resize(5*n);
+    rhs.assign(n, {0.});
+    T_eta_m.assign(n, {0.});
+    T_eta_p.assign(n, {0.});
+    const int n_direc = DATA.boost_invariant ? 2 : 3;
+    for (int direction = 1; direction <= n_direc; direction++) {
+        if (direction == 2) {
+            fill_row(1, -2, 0, 0, n); fill_row(2, -1, 0, 0, n);
+            fill_row(3,  1, 0, 0, n); fill_row(4,  2, 0, 0, n);
+        } else if (direction == 3) {
+            fill_row(1, 0, -2, 0, n); fill_row(2, 0, -1, 0, n);
+            fill_row(3, 0,  1, 0, n); fill_row(4, 0,  2, 0, n);
+        }
+        for (int alpha = 0; alpha < 5; alpha++) {
+            const double *u0 = row(0, alpha);
+            const double *um2, *um1, *up1, *up2;
+            if (direction == 1) {
+                um2 = u0 - 2; um1 = u0 - 1; up1 = u0 + 1; up2 = u0 + 2;
+            } else {
+                um2 = row(1, alpha); um1 = row(2, alpha);
+                up1 = row(3, alpha); up2 = row(4, alpha);
+            }
+            double *phL = &qphL[alpha*n];
+            double *phR = &qphR[alpha*n];
+            double *mhL = &qmhL[alpha*n];
+            double *mhR = &qmhR[alpha*n];
+            double *s   = slope.data();
+
+            minmod.minmod_dx(up1, u0, um1, s, n);
+            #pragma omp simd
+            for (int i = 0; i < n; i++) {
+                const double fphL = 0.5*s[i];
+                phL[i] = u0[i] + fphL;
+                mhR[i] = u0[i] + (-fphL);
+            }
+            minmod.minmod_dx(up2, up1, u0, s, n);
+            #pragma omp simd
+            for (int i = 0; i < n; i++) {
+                phR[i] = up1[i] + (-0.5*s[i]);
+            }
+            minmod.minmod_dx(u0, um1, um2, s, n);
+            #pragma omp simd
+            for (int i = 0; i < n; i++) {
+                mhL[i] = um1[i] + 0.5*s[i];
+            }
+        }
+
+        for (int i = 0; i < n; i++) {
+            TJbVec qiphL, qiphR, qimhL, qimhR;
+            for (int alpha = 0; alpha < 5; alpha++) {
+                qiphL[alpha] = qphL[alpha*n + i];
+                qiphR[alpha] = qphR[alpha*n + i];
+                qimhL[alpha] = qmhL[alpha*n + i];
+                qimhR[alpha] = qmhR[alpha*n + i];
+            }
+            KTFluxes(tau, direction, arena_current(ix_begin + i, iy, ieta),
+                     qiphL, qiphR, qimhL, qimhR,
+                     rhs[i], T_eta_m[i], T_eta_p[i]);
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (DATA.boost_invariant) {
+            TJbVec q_cell;
+            for (int alpha = 0; alpha < 5; alpha++) {
+                q_cell[alpha] = row(0, alpha)[i];
+            }
+            BoostInvariantEtaFluxes(tau, q_cell,
+                                    arena_current(ix_begin + i, iy, ieta),
+                                    T_eta_m[i], T_eta_p[i]);
+        }
+        AddEtaFluxes(T_eta_m[i], T_eta_p[i], rhs[i]);
+        for (int alpha = 0; alpha < 5; alpha++) {
+            qi[i][alpha] = row(0, alpha)[i] + rhs[i][alpha];
+        }
+    }
+}
+
+//! the face with index (ix, iy, ieta) along direction lies between the
+//! cell (ix, iy, ieta) and its lower neighbour, so the half-way states
+//! are qiphL and qiphR of the lower cell (= qimhL and qimhR of the upper
+//! one). Each state is reconstructed with the cell it is extrapolated
+//! from as the initial guess. MakeDeltaQI uses the updated cell for all
+//! four states instead; the guess only enters when the reconstruction
+//! fails (revert_grid and the u0 jump check), where the two kernels
+//! then differ.
+template <class Cell>
+template <class GridType, class QGridType>
+void AdvanceT<Cell>::KTFaceFlux(const double tau,
+                                const GridType &arena_current,
+                                const QGridType &q_grid,
+                                const int direction, const int ix,
+                                const int iy, const int ieta, TJbVec &flux) {
+    const double tau_fac[4] = {0.0, tau, tau, 1.0};
+    const int dx   = (direction == 1) ? 1 : 0;
+    const int dy   = (direction == 2) ? 1 : 0;
+    const int deta = (direction == 3) ? 1 : 0;
+    const auto &m2 = q_grid.getHalo(ix - 2*dx, iy - 2*dy, ieta - 2*deta);
+    const auto &m1 = q_grid.getHalo(ix - dx, iy - dy, ieta - deta);
+    const auto &c  = q_grid.getHalo(ix, iy, ieta);
+    const auto &p1 = q_grid.getHalo(ix + dx, iy + dy, ieta + deta);
+
+    TJbVec qL = {0.};
+    TJbVec qR = {0.};
+    for (int alpha = 0; alpha < 5; alpha++) {
+        const double gm2 = get_tauTJb0(m2, alpha, tau);
+        const double gm1 = get_tauTJb0(m1, alpha, tau);
+        const double g0  = get_tauTJb0(c,  alpha, tau);
+        const double gp1 = get_tauTJb0(p1, alpha, tau);
+        qL[alpha] = gm1 +  0.5*minmod.minmod_dx(g0, gm1, gm2);
+        qR[alpha] = g0  + -0.5*minmod.minmod_dx(gp1, g0, gm1);
+    }
+
+    auto grid_L = reconst_helper.ReconstIt_shell(
+                tau, qL, arena_current.getHalo(ix - dx, iy - dy, ieta - deta));
+    auto grid_R = reconst_helper.ReconstIt_shell(
+                tau, qR, arena_current.getHalo(ix, iy, ieta));
+    const double a = std::max(MaxSpeed(tau, direction, grid_L),
+                              MaxSpeed(tau, direction, grid_R));
+    for (int alpha = 0; alpha < 5; alpha++) {
+        const double FL = get_TJb(grid_L, 0, alpha, direction)*tau_fac[direction];
+        const double FR = get_TJb(grid_R, 0, alpha, direction)*tau_fac[direction];
+        flux[alpha] = 0.5*((FL + FR) - a*(qR[alpha] - qL[alpha]));
+    }
+}
 
-        double aiphL = MaxSpeed(tau, direction, grid_phL);
-        double aiphR = MaxSpeed(tau, direction, grid_phR);
-        double aimhL = MaxSpeed(tau, direction, grid_mhL);
-        double aimhR = MaxSpeed(tau, direction, grid_mhR);
 
-        double aiph = std::max(aiphL, aiphR);
-        double aimh = std::max(aimhL, aimhR);
+template <class Cell>
+template <class GridType, class QGridType>
+void AdvanceT<Cell>::MakeFaceFluxes(const double tau,
+                                    const GridType &arena_current,
+                                    const QGridType &q_grid,
+                                    const GridBox &box,
+                                    const std::array<int, 3> &brick) {
+    const int nx = arena_current.nX();
+    const int ny = arena_current.nY();
+    const int n_faces = (nx + 1)*(ny + 1)*(arena_current.nEta() + 1);
+    if (static_cast<int>(face_flux.size()) != n_faces) {
+        face_flux = std::vector<TJbVec, FirstTouchAllocator<TJbVec>>(n_faces);
+        face_rhs  = std::vector<TJbVec, FirstTouchAllocator<TJbVec>>(n_faces);
+    }
+    auto idx = [nx, ny](const int ix, const int iy, const int ieta) {
+        return((ieta*(ny + 1) + iy)*(nx + 1) + ix);
+    };
+    const double delta[4] = {0.0, DATA.delta_x, DATA.delta_y, DATA.delta_eta};
+
+    // DeltaQIFromFaces takes the eta fluxes of a boost-invariant grid from
+    // BoostInvariantEtaFluxes
+    const int n_direc = DATA.boost_invariant ? 2 : 3;
+    for (int direction = 1; direction <= n_direc; direction++) {
+        GridBox face_box = box;
+        face_box.hi[direction - 1]++;
+        Brickloop(face_box, brick, [&](const int ix, const int iy,
+                                       const int ieta) {
+            KTFaceFlux(tau, arena_current, q_grid, direction, ix, iy, ieta,
+                       face_flux[idx(ix, iy, ieta)]);
+        });
+        if (direction == 3) break;  // differenced in DeltaQIFromFaces
+
+        const int dx = (direction == 1) ? 1 : 0;
+        const int dy = (direction == 2) ? 1 : 0;
+        Brickloop(box, brick, [&](const int ix, const int iy,
+                                  const int ieta) {
+            const TJbVec &Fimh = face_flux[idx(ix, iy, ieta)];
+            const TJbVec &Fiph = face_flux[idx(ix + dx, iy + dy, ieta)];
+            TJbVec &rhs = face_rhs[idx(ix, iy, ieta)];
+            for (int alpha = 0; alpha < 5; alpha++) {
+                double DFmmp = (Fimh[alpha] - Fiph[alpha])/delta[direction];
+                if (direction == 1) rhs[alpha] = 0.;
+                rhs[alpha] += DFmmp*(DATA.delta_tau);
+            }
+        });
+    }
+}
+
 
+template <class Cell>
+template <class GridType, class QGridType>
+void AdvanceT<Cell>::DeltaQIFromFaces(const double tau,
+                                      const GridType &arena_current,
+                                      const QGridType &q_grid,
+                                      const int ix, const int iy,
+                                      const int ieta, TJbVec &qi) {
+    const int nx = q_grid.nX();
+    const int ny = q_grid.nY();
+    TJbVec rhs = face_rhs[(ieta*(ny + 1) + iy)*(nx + 1) + ix];
+    for (int alpha = 0; alpha < 5; alpha++) {
+        qi[alpha] = get_tauTJb0(q_grid(ix, iy, ieta), alpha, tau);
+    }
+    EnergyFlowVec T_eta_m = {0.};
+    EnergyFlowVec T_eta_p = {0.};
+    if (DATA.boost_invariant) {
+        BoostInvariantEtaFluxes(tau, qi, arena_current(ix, iy, ieta),
+                                T_eta_m, T_eta_p);
+    } else {
+        const TJbVec &Fimh = face_flux[(ieta*(ny + 1) + iy)*(nx + 1) + ix];
+        const TJbVec &Fiph = face_flux[((ieta + 1)*(ny + 1) + iy)*(nx + 1)
+                                       + ix];
         for (int alpha = 0; alpha < 5; alpha++) {
-            double FiphL = get_TJb(grid_phL, 0, alpha, direction)*tau_fac[direction];
-            double FiphR = get_TJb(grid_phR, 0, alpha, direction)*tau_fac[direction];
-            double FimhL = get_TJb(grid_mhL, 0, alpha, direction)*tau_fac[direction];
-            double FimhR = get_TJb(grid_mhR, 0, alpha, direction)*tau_fac[direction];
-
-            // KT: H_{j+1/2} = (f(u^+_{j+1/2}) + f(u^-_{j+1/2})/2
-            //                  - a_{j+1/2}(u_{j+1/2}^+ - u^-_{j+1/2})/2
-            double Fiph = 0.5*((FiphL + FiphR)
-                               - aiph*(qiphR[alpha] - qiphL[alpha]));
-            double Fimh = 0.5*((FimhL + FimhR)
-                               - aimh*(qimhR[alpha] - qimhL[alpha]));
-            if (direction == 3 && (alpha == 0 || alpha == 3)) {
-                T_eta_m[alpha] = Fimh;
-                T_eta_p[alpha] = Fiph;
+            if (alpha == 0 || alpha == 3) {
+                T_eta_m[alpha] = Fimh[alpha];
+                T_eta_p[alpha] = Fiph[alpha];
             } else {
-                double DFmmp = (Fimh - Fiph)/delta[direction];
+                double DFmmp = (Fimh[alpha] - Fiph[alpha])/DATA.delta_eta;
                 rhs[alpha] += DFmmp*(DATA.delta_tau);
             }
         }
-    });
+    }
+    AddEtaFluxes(T_eta_m, T_eta_p, rhs);
+
+    for (int alpha = 0; alpha < 5; alpha++) {
+        qi[alpha] += rhs[alpha];
+    }
+}
+
+
+//! the eta half-way states of a cell on a boost-invariant grid
+//! (neta = 1) all equal the cell itself, so the KT fluxes through both
+//! eta faces reduce to T^{eta mu} of its reconstructed state
+template <class Cell>
+template <class CellType>
+void AdvanceT<Cell>::BoostInvariantEtaFluxes(const double tau,
+                                             const TJbVec &q,
+                                             const CellType &c,
+                                             EnergyFlowVec &T_eta_m,
+                                             EnergyFlowVec &T_eta_p) {
+    auto grid_c = reconst_helper.ReconstIt_shell(tau, q, c);
+    for (const int alpha : {0, 3}) {
+        T_eta_m[alpha] = get_TJb(grid_c, 0, alpha, 3);
+        T_eta_p[alpha] = T_eta_m[alpha];
+    }
+}
+
+
+//! Kurganov-Tadmor fluxes through the two faces of a cell along direction
+//! from the half-way states qiphL, qiphR (at +1/2) and qimhL, qimhR (at
+//! -1/2); c is the initial guess of the reconstruction. The tau and z
+//! components of the eta fluxes are collected in T_eta_m and T_eta_p for
+//! AddEtaFluxes, everything else is added to rhs.
+template <class Cell>
+template <class CellType>
+void AdvanceT<Cell>::KTFluxes(const double tau, const int direction,
+                              const CellType &c,
+                              const TJbVec &qiphL, const TJbVec &qiphR,
+                              const TJbVec &qimhL, const TJbVec &qimhR,
+                              TJbVec &rhs, EnergyFlowVec &T_eta_m,
+                              EnergyFlowVec &T_eta_p) {
+    const double delta[4]   = {0.0, DATA.delta_x, DATA.delta_y, DATA.delta_eta};
+    const double tau_fac[4] = {0.0, tau, tau, 1.0};
+
+    // for each direction, reconstruct half-way cells
+    // reconstruct e, rhob, and u[4] for half way cells
+    auto grid_phL = reconst_helper.ReconstIt_shell(tau, qiphL, c);
+    auto grid_phR = reconst_helper.ReconstIt_shell(tau, qiphR, c);
+    auto grid_mhL = reconst_helper.ReconstIt_shell(tau, qimhL, c);
+    auto grid_mhR = reconst_helper.ReconstIt_shell(tau, qimhR, c);
+
+    double aiphL = MaxSpeed(tau, direction, grid_phL);
+    double aiphR = MaxSpeed(tau, direction, grid_phR);
+    double aimhL = MaxSpeed(tau, direction, grid_mhL);
+    double aimhR = MaxSpeed(tau, direction, grid_mhR);
+
+    double aiph = std::max(aiphL, aiphR);
+    double aimh = std::max(aimhL, aimhR);
 
-    // add longitudinal flux with discretized geometric terms
-    double cosh_deta = cosh(delta[3]/2.)/std::max(delta[3], Util::small_eps);
-    double sinh_deta = sinh(delta[3]/2.)/std::max(delta[3], Util::small_eps);
+    for (int alpha = 0; alpha < 5; alpha++) {
+        double FiphL = get_TJb(grid_phL, 0, alpha, direction)*tau_fac[direction];
+        double FiphR = get_TJb(grid_phR, 0, alpha, direction)*tau_fac[direction];
+        double FimhL = get_TJb(grid_mhL, 0, alpha, direction)*tau_fac[direction];
+        double FimhR = get_TJb(grid_mhR, 0, alpha, direction)*tau_fac[direction];
+
+        // KT: H_{j+1/2} = (f(u^+_{j+1/2}) + f(u^-_{j+1/2})/2
+        //                  - a_{j+1/2}(u_{j+1/2}^+ - u^-_{j+1/2})/2
+        double Fiph = 0.5*((FiphL + FiphR)
+                           - aiph*(qiphR[alpha] - qiphL[alpha]));
+        double Fimh = 0.5*((FimhL + FimhR)
+                           - aimh*(qimhR[alpha] - qimhL[alpha]));
+        if (direction == 3 && (alpha == 0 || alpha == 3)) {
+            T_eta_m[alpha] = Fimh;
+            T_eta_p[alpha] = Fiph;
+        } else {
+            double DFmmp = (Fimh - Fiph)/delta[direction];
+            rhs[alpha] += DFmmp*(DATA.delta_tau);
+        }
+    }
+}
+
+
+//! adds the longitudinal fluxes with the discretized geometric terms
+template <class Cell>
+void AdvanceT<Cell>::AddEtaFluxes(const EnergyFlowVec &T_eta_m,
+                                  const EnergyFlowVec &T_eta_p, TJbVec &rhs) {
+    const double delta_eta = DATA.delta_eta;
+    double cosh_deta = cosh(delta_eta/2.)/std::max(delta_eta, Util::small_eps);
+    double sinh_deta = sinh(delta_eta/2.)/std::max(delta_eta, Util::small_eps);
     sinh_deta = std::max(0.5, sinh_deta);
     if (DATA.boost_invariant) {
         // if the simulation is boost-invariant,
@@ -549,15 +1109,18 @@ void Advance::MakeDeltaQI(const double tau, SCGrid &arena_current,
     // geometric terms
     //rhs[0] -= get_TJb(arena_current(ix, iy, ieta), 3, 3)*DATA.delta_tau;
     //rhs[3] -= get_TJb(arena_current(ix, iy, ieta), 3, 0)*DATA.delta_tau;
-
-    for (int i = 0; i < 5; i++) {
-        qi[i] += rhs[i];
-    }
 }
 
 // determine the maximum signal propagation speed at the given direction
-double Advance::MaxSpeed(const double tau, const int direc,
-                         const ReconstCell &grid_p) {
+template <class Cell>
+double AdvanceT<Cell>::MaxSpeed(const double tau, const int direc,
+                                const ReconstCell &grid_p) {
+    return(MaxSpeed(tau, direc, grid_p, eos.get_cs2(grid_p.e, grid_p.rhob)));
+}
+
+template <class Cell>
+double AdvanceT<Cell>::MaxSpeed(const double tau, const int direc,
+                                const ReconstCell &grid_p, const double vs2) {
     double g[] = {1., 1., 1./tau};
 
     double utau    = grid_p.u[0];
@@ -568,7 +1131,6 @@ double Advance::MaxSpeed(const double tau, const int direc,
     double eps  = grid_p.e;
     double rhob = grid_p.rhob;
 
-    double vs2 = eos.get_cs2(eps, rhob);
     double num_temp_sqrt = (ut2mux2 - (ut2mux2 - 1.)*vs2)*vs2;
     double num;
     if (num_temp_sqrt >= 0)  {
@@ -626,33 +1188,62 @@ double Advance::MaxSpeed(const double tau, const int direc,
     return f;
 }
 
-double Advance::get_TJb(const ReconstCell &grid_p, const int rk_flag,
-                        const int mu, const int nu) {
-    assert(mu < 5); assert(mu > -1);
-    assert(nu < 4); assert(nu > -1);
-    double rhob = grid_p.rhob;
-    const double u_nu = grid_p.u[nu];
-    if (mu == 4) {
-        return rhob*u_nu;
-    }
-    double e = grid_p.e;
-    double gfac = 0.0;
-    double u_mu = 0.0;
-    if (mu == nu) {
-        u_mu = u_nu;
-        gfac = 1.0;
-        if (mu == 0) {
-            gfac = -1.0;
+template <class Cell>
+void AdvanceT<Cell>::MaxTimeSteps(const double tau, const Grid &arena,
+                                  double &dtau_cfl, double &dtau_relax) {
+    const GridBox &box = active_box;
+    const double inv_h[3] = {1./DATA.delta_x, 1./DATA.delta_y,
+                             1./DATA.delta_eta};
+    const int n_direc = DATA.boost_invariant ? 2 : 3;
+    // the implicit relaxation terms are stable for any step, so the
+    // relaxation times are only evaluated for the explicit update
+    const bool explicit_relaxation = (DATA.semi_implicit_relaxation == 0);
+    const bool with_shear = (DATA.viscosity_flag == 1
+                             && DATA.turn_on_shear == 1
+                             && explicit_relaxation);
+    const bool with_bulk  = (DATA.viscosity_flag == 1
+                             && DATA.turn_on_bulk == 1
+                             && explicit_relaxation);
+    double max_rate = 0.;
+    double min_relax_time = 10.;
+    #pragma omp parallel for collapse(2) reduction(max:max_rate) \
+                                         reduction(min:min_relax_time)
+    for (int ieta = box.lo[2]; ieta < box.hi[2]; ieta++)
+    for (int iy   = box.lo[1]; iy   < box.hi[1]; iy++  )
+    for (int ix   = box.lo[0]; ix   < box.hi[0]; ix++  ) {
+        const Cell &c = arena(ix, iy, ieta);
+        const ReconstCell grid_p = {c.epsilon, c.rhob, c.u};
+        const double cs2 = eos.get_cs2(c.epsilon, c.rhob);
+        // signal crossings per unit time, summed over the directions of
+        // the unsplit KT update
+        double rate = 0.;
+        for (int direc = 1; direc <= n_direc; direc++) {
+            rate += MaxSpeed(tau, direc, grid_p, cs2)*inv_h[direc-1];
+        }
+        max_rate = std::max(max_rate, rate);
+        if (!with_shear && !with_bulk) continue;
+
+        const CellThermo thermo = get_thermo<true>(c, tau);
+        double eta_v, tau_relax;
+        if (with_shear) {
+            diss_helper.get_shear_coefficients(c.epsilon, thermo,
+                                               eta_v, tau_relax);
+            min_relax_time = std::min(min_relax_time, tau_relax);
+        }
+        if (with_bulk) {
+            diss_helper.get_bulk_coefficients(c.epsilon, thermo,
+                                              eta_v, tau_relax);
+            min_relax_time = std::min(min_relax_time, tau_relax);
         }
-    } else {
-        u_mu = grid_p.u[mu];
     }
-    const double pressure = eos.get_pressure(e, rhob);
-    const double T_munu   = (e + pressure)*u_mu*u_nu + pressure*gfac;
-    return(T_munu);
+    dtau_cfl   = DATA.cfl_number/std::max(max_rate, Util::small_eps);
+    dtau_relax = min_relax_time/3.;
+    if (!explicit_relaxation) dtau_relax = std::numeric_limits<double>::max();
 }
 
-double Advance::get_TJb(const Cell_small &grid_p, const int mu, const int nu) {
+template <class Cell>
+double AdvanceT<Cell>::get_TJb(const ReconstCell &grid_p, const int rk_flag,
+                               const int mu, const int nu) {
     assert(mu < 5); assert(mu > -1);
     assert(nu < 4); assert(nu > -1);
     double rhob = grid_p.rhob;
@@ -660,7 +1251,7 @@ double Advance::get_TJb(const Cell_small &grid_p, const int mu, const int nu) {
     if (mu == 4) {
         return rhob*u_nu;
     }
-    double e = grid_p.epsilon;
+    double e = grid_p.e;
     double gfac = 0.0;
     double u_mu = 0.0;
     if (mu == nu) {
@@ -676,3 +1267,13 @@ double Advance::get_TJb(const Cell_small &grid_p, const int mu, const int nu) {
     const double T_munu   = (e + pressure)*u_mu*u_nu + pressure*gfac;
     return(T_munu);
 }
+
+//! the compact ideal cell carries no W^{mu nu}, so only the ideal kernel
+//! exists for it
+template <>
+void AdvanceT<Cell_ideal>::select_physics_kernel() {
+    advance_kernel = &AdvanceT::AdvanceItT<IdealPhysics>;
+}
+
+template class AdvanceT<Cell_small>;
+template class AdvanceT<Cell_ideal>;
@@ -2,7 +2,9 @@
 #ifndef SRC_ADVANCE_H_
 #define SRC_ADVANCE_H_
 
+#include <cassert>
 #include <memory>
+#include <type_traits>
 #include "data.h"
 #include "cell.h"
 #include "grid.h"
@@ -13,35 +15,176 @@
 #include "hydro_source_base.h"
 #include "pretty_ostream.h"
 
-class Advance {
+//! compile-time physics configuration of the RK kernels. The kernels are
+//! instantiated for every combination once, and Advance selects the one
+//! matching the run parameters at construction.
+template <bool viscous, bool with_shear, bool with_bulk, bool with_diff>
+struct PhysicsConfig {
+    static constexpr bool viscosity = viscous;
+    static constexpr bool shear     = with_shear;
+    static constexpr bool bulk      = with_bulk;
+    static constexpr bool diff      = with_diff;
+};
+
+typedef PhysicsConfig<false, false, false, false> IdealPhysics;
+
+//! stage rk_flag of the strong-stability-preserving Runge-Kutta schemes
+//! (rk_order 1, 2 and 3) in Shu-Osher form. The stage reads the state u
+//! at tau + c*dtau and writes
+//!     a*u^n + b*(u + dtau*L(u)),   b = 1 - a,
+//! at tau + c_out*dtau, where u^n is the state at tau. All stages keep
+//! u^n in arena_prev, so the scheme needs no more than three arenas.
+struct RKStage {
+    double a;
+    double b;
+    double c;
+    double c_out;
+};
+
+inline RKStage get_rk_stage(const int rk_order, const int rk_flag) {
+    static const RKStage heun[2] = {{0.,  1.,  0., 1.},
+                                    {0.5, 0.5, 1., 1.}};
+    static const RKStage ssp_rk3[3] = {{0.,    1.,    0.,  1. },
+                                       {0.75,  0.25,  1.,  0.5},
+                                       {1./3., 2./3., 0.5, 1. }};
+    return(rk_order == 3 ? ssp_rk3[rk_flag] : heun[rk_flag]);
+}
+
+template <class Cell>
+class AdvanceT {
  private:
+    typedef GridT<Cell> Grid;
+
     const InitData &DATA;
     const EOS &eos;
     std::shared_ptr<HydroSourceBase> hydro_source_terms_ptr;
 
     Diss diss_helper;
+    U_derivative_poolT<Cell> u_derivative_helpers;
     Minmod minmod;
     Reconst reconst_helper;
     pretty_ostream music_message;
 
     bool flag_add_hydro_source;
 
+    //! structure-of-arrays copy of arena_current for the stencil kernels
+    SCGridSoA arena_current_soa;
+
+    typedef void (AdvanceT::*AdvanceKernel)(const double, Grid&, Grid&,
+                                            Grid&, const int, const int,
+                                            const int);
+    //! AdvanceItT instantiation matching the physics flags in DATA
+    AdvanceKernel advance_kernel;
+
+    //! cells evolved by AdvanceIt when active_region_eps_cut > 0
+    GridBox active_box;
+
+    //! derivative fields at tau already computed for other readers; the
+    //! first RK stage takes the gradients of these cells from there
+    const DerivedFieldSliceT<Cell> *first_stage_fields = nullptr;
+
+    //! scratch buffers of the face flux kernel: the KT flux through the
+    //! lower face of every cell along one direction ((nx+1)*(ny+1)*(neta+1)
+    //! faces), and the flux differences accumulated per cell
+    std::vector<TJbVec, FirstTouchAllocator<TJbVec>> face_flux;
+    std::vector<TJbVec, FirstTouchAllocator<TJbVec>> face_rhs;
+
+    //! scratch of the pencil flux kernel, one per OpenMP thread; the
+    //! vectors keep their capacity from pencil to pencil
+    struct PencilScratch {
+        std::vector<double> q, slope, qphL, qphR, qmhL, qmhR;
+        std::vector<TJbVec> rhs, qi;
+        std::vector<EnergyFlowVec> T_eta_m, T_eta_p;
+    };
+    std::vector<PencilScratch> pencil_scratch;
+
+    //! primitive cache (use_primitive_cache): the EOS values and
+    //! tau*T^{tau mu} of arena_current at the first stage ([0], u^n, read
+    //! by the source terms of all stages) and at the current later one
+    GridT<CellThermo> thermo_cache[2];
+
+    void select_physics_kernel();
+
  public:
-    Advance(const EOS &eosIn, const InitData &DATA_in,
+    AdvanceT(const EOS &eosIn, const InitData &DATA_in,
             std::shared_ptr<HydroSourceBase> hydro_source_ptr_in);
 
+    //! restricts the following RK stages to box; the cells outside of it
+    //! are copied unchanged (only used if active_region_eps_cut > 0)
+    void set_active_box(const GridBox &box) {active_box = box;}
+
+    //! the derivative fields between arena_prev and arena_current of the
+    //! next first stage (nullptr: none)
+    void set_first_stage_fields(const DerivedFieldSliceT<Cell> *fields) {
+        first_stage_fields = fields;
+    }
+
+    void AdvanceIt(const double tau_init,
+                   Grid &arena_prev, Grid &arena_current,
+                   Grid &arena_future, const int rk_flag) {
+        (this->*advance_kernel)(tau_init, arena_prev, arena_current,
+                                arena_future, rk_flag, 0,
+                                arena_current.nEta());
+    }
+
+    //! AdvanceIt for the eta slab ieta_begin <= ieta < ieta_end only. The
+    //! stencils read arena_current two cells beyond the slab, which must
+    //! hold the input of the stage there already.
     void AdvanceIt(const double tau_init,
-                   SCGrid &arena_prev, SCGrid &arena_current,
-                   SCGrid &arena_future, const int rk_flag);
+                   Grid &arena_prev, Grid &arena_current,
+                   Grid &arena_future, const int rk_flag,
+                   const int ieta_begin, const int ieta_end) {
+        (this->*advance_kernel)(tau_init, arena_prev, arena_current,
+                                arena_future, rk_flag, ieta_begin, ieta_end);
+    }
 
+    template <class Physics>
+    void AdvanceItT(const double tau_init,
+                    Grid &arena_prev, Grid &arena_current,
+                    Grid &arena_future, const int rk_flag,
+                    const int ieta_begin, const int ieta_end);
+
+    template <class GridType, class QGridType, class Func>
+    void FluxSweep(const double tau_rk, const GridType &arena_current,
+                   const QGridType &q_grid, const GridBox &box,
+                   const std::array<int, 3> &brick, const int rk_flag,
+                   Func update_cell);
+
+    template <class Physics>
+    void FillThermoCache(const double tau_rk, const Grid &arena_current,
+                         const GridBox &box, GridT<CellThermo> &cache);
+
+    template <class Physics>
     void FirstRKStepT(const double tau, const double x_local,
                       const double y_local, const double eta_s_local,
-                      SCGrid &arena_current, SCGrid &arena_future,
-                      SCGrid &arena_prev, const int ix, const int iy,
-                      const int ieta, const int rk_flag);
+                      Grid &arena_current, Grid &arena_future,
+                      Grid &arena_prev, const int ix, const int iy,
+                      const int ieta, const int rk_flag, TJbVec qi);
+
+    //! velocity gradients and W^{mu nu} update of one cell; the
+    //! false_type overload keeps FirstRKStepW out of the ideal kernels
+    template <class Physics>
+    void AdvanceViscousCell(const double tau, Grid &arena_prev,
+                            Grid &arena_current, Grid &arena_future,
+                            const int rk_flag, const int ix, const int iy,
+                            const int ieta, std::true_type);
+    template <class Physics>
+    void AdvanceViscousCell(const double, Grid&, Grid&, Grid&, const int,
+                            const int, const int, const int,
+                            std::false_type) {}
+
+    //! partial_a W^{a mu}; identically zero for ideal hydrodynamics
+    template <class Physics>
+    void MakeWSource(const double tau_rk, const Grid &arena_current,
+                     const Grid &arena_prev, const int ix, const int iy,
+                     const int ieta, TJbVec &dwmn, std::true_type);
+    template <class Physics>
+    void MakeWSource(const double, const Grid&, const Grid&, const int,
+                     const int, const int, TJbVec&, std::false_type) {}
 
-    void FirstRKStepW(const double tau_it, SCGrid &arena_prev,
-                      SCGrid &arena_current, SCGrid &arena_future,
+    template <class Physics>
+    void FirstRKStepW(const double tau_it, Grid &arena_prev,
+                      Grid &arena_current, Grid &arena_future,
                       const int rk_flag, const double theta_local,
                       const DumuVec &a_local,
                       const VelocityShearVec &sigma_local,
@@ -49,21 +192,153 @@ class Advance {
                       const DmuMuBoverTVec &baryon_diffusion_vector,
                       const int ieta, const int ix, const int iy);
 
-    void UpdateTJbRK(const ReconstCell &grid_rk, Cell_small &grid_pt);
+    void UpdateTJbRK(const ReconstCell &grid_rk, Cell &grid_pt);
     void QuestRevert(const double tau, Cell_small *grid_pt,
                      const int ieta, const int ix, const int iy);
     void QuestRevert_qmu(const double tau, Cell_small *grid_pt,
                          const int ieta, const int ix, const int iy);
 
-    void MakeDeltaQI(const double tau, SCGrid &arena_current,
-                     const int ix, const int iy, const int ieta, TJbVec &qi,
+    template <class GridType, class QGridType>
+    void MakeDeltaQI(const double tau, const GridType &arena_current,
+                     const QGridType &q_grid, const int ix, const int iy, const int ieta, TJbVec &qi,
                      const int rk_flag);
+
+    //! MakeDeltaQI of the cells ix_begin <= ix < ix_end of row (iy, ieta),
+    //! with the slope limiter vectorized along the pencil
+    template <class GridType, class QGridType>
+    void MakeDeltaQIPencil(const double tau, const GridType &arena_current,
+                           const QGridType &q_grid, const int ix_begin, const int ix_end,
+                           const int iy, const int ieta, TJbVec *qi,
+                           const int rk_flag);
+
+    //! KT flux through the face between cell (ix, iy, ieta) and its lower
+    //! neighbour along direction, as in MakeDeltaQI
+    template <class GridType, class QGridType>
+    void KTFaceFlux(const double tau, const GridType &arena_current,
+                    const QGridType &q_grid, const int direction, const int ix, const int iy,
+                    const int ieta, TJbVec &flux);
+
+    //! MakeDeltaQI for all cells of box by a face-centred pass per
+    //! direction, which computes every interface flux only once; the
+    //! rhs without the eta fluxes of T^{tau tau} and T^{tau eta} is left
+    //! in face_rhs and the eta face fluxes in face_flux
+    template <class GridType, class QGridType>
+    void MakeFaceFluxes(const double tau, const GridType &arena_current,
+                        const QGridType &q_grid, const GridBox &box, const std::array<int, 3> &brick);
+
+    //! qi of cell (ix, iy, ieta) from the buffers of MakeFaceFluxes
+    template <class GridType, class QGridType>
+    void DeltaQIFromFaces(const double tau, const GridType &arena_current,
+                          const QGridType &q_grid,
+                          const int ix, const int iy, const int ieta,
+                          TJbVec &qi);
+
+    //! T_eta_m and T_eta_p of KTFluxes for a cell of a boost-invariant
+    //! grid from its tau*T^{tau mu} q, with one reconstruction instead
+    //! of four (c is the initial guess)
+    template <class CellType>
+    void BoostInvariantEtaFluxes(const double tau, const TJbVec &q,
+                                 const CellType &c, EnergyFlowVec &T_eta_m,
+                                 EnergyFlowVec &T_eta_p);
+
+    template <class CellType>
+    void KTFluxes(const double tau, const int direction, const CellType &c,
+                  const TJbVec &qiphL, const TJbVec &qiphR,
+                  const TJbVec &qimhL, const TJbVec &qimhR, TJbVec &rhs,
+                  EnergyFlowVec &T_eta_m, EnergyFlowVec &T_eta_p);
+    void AddEtaFluxes(const EnergyFlowVec &T_eta_m,
+                      const EnergyFlowVec &T_eta_p, TJbVec &rhs);
     double MaxSpeed(const double tau, const int direc,
                     const ReconstCell &grid_p);
+    //! MaxSpeed with the speed of sound squared of grid_p already known
+    double MaxSpeed(const double tau, const int direc,
+                    const ReconstCell &grid_p, const double vs2);
+
+    //! largest stable time steps for the state of arena at tau over the
+    //! active box: dtau_cfl from the CFL condition with the KT signal
+    //! speeds, dtau_relax a third of the shortest shear or bulk relaxation
+    //! time (10 fm for ideal hydrodynamics, no limit with the
+    //! semi-implicit relaxation)
+    void MaxTimeSteps(const double tau, const Grid &arena,
+                      double &dtau_cfl, double &dtau_relax);
 
     double get_TJb(const ReconstCell &grid_p, const int rk_flag,
                    const int mu, const int nu);
-    double get_TJb(const Cell_small &grid_p, const int mu, const int nu);
+
+    //! T^{mu nu} (mu < 4) or J^nu (mu = 4) of a Cell_small or CellSoAView
+    template <class CellType>
+    double get_TJb(const CellType &grid_p, const int mu, const int nu) {
+        assert(mu < 5); assert(mu > -1);
+        if (mu == 4) {
+            return grid_p.rhob*grid_p.u[nu];
+        }
+        return(get_TJb(grid_p, mu, nu,
+                       eos.get_pressure(grid_p.epsilon, grid_p.rhob)));
+    }
+
+    //! get_TJb with the pressure of the cell already known
+    template <class CellType>
+    double get_TJb(const CellType &grid_p, const int mu, const int nu,
+                   const double pressure) {
+        assert(mu < 5); assert(mu > -1);
+        assert(nu < 4); assert(nu > -1);
+        double rhob = grid_p.rhob;
+        const double u_nu = grid_p.u[nu];
+        if (mu == 4) {
+            return rhob*u_nu;
+        }
+        double e = grid_p.epsilon;
+        double gfac = 0.0;
+        double u_mu = 0.0;
+        if (mu == nu) {
+            u_mu = u_nu;
+            gfac = 1.0;
+            if (mu == 0) {
+                gfac = -1.0;
+            }
+        } else {
+            u_mu = grid_p.u[mu];
+        }
+        const double T_munu   = (e + pressure)*u_mu*u_nu + pressure*gfac;
+        return(T_munu);
+    }
+
+    //! tau*T^{tau mu} (mu < 4) or tau*J^tau (mu = 4) of a cell; taken
+    //! from the primitive cache for a CellThermo
+    template <class CellType>
+    double get_tauTJb0(const CellType &grid_p, const int mu,
+                       const double tau) {
+        return(tau*get_TJb(grid_p, mu, 0));
+    }
+    double get_tauTJb0(const CellThermo &thermo, const int mu,
+                       const double) {
+        return(thermo.tauTJb0[mu]);
+    }
+
+    //! EOS values (only the pressure unless with_diss) and tau*T^{tau mu}
+    //! of a cell
+    template <bool with_diss, class CellType>
+    CellThermo get_thermo(const CellType &grid_p, const double tau) {
+        const double e    = grid_p.epsilon;
+        const double rhob = grid_p.rhob;
+        CellThermo thermo;
+        if (with_diss) {
+            const EOSThermo eos_thermo = eos.get_thermo(e, rhob);
+            thermo.pressure = eos_thermo.pressure;
+            thermo.T        = eos_thermo.T;
+            thermo.cs2      = eos_thermo.cs2;
+            thermo.muB      = eos_thermo.muB;
+            thermo.entropy  = eos_thermo.entropy;
+        } else {
+            thermo.pressure = eos.get_pressure(e, rhob);
+        }
+        for (int mu = 0; mu < 5; mu++) {
+            thermo.tauTJb0[mu] = tau*get_TJb(grid_p, mu, 0, thermo.pressure);
+        }
+        return(thermo);
+    }
 };
 
+typedef AdvanceT<Cell_small> Advance;
+
 #endif  // SRC_ADVANCE_H_
@@ -0,0 +1,5 @@
+// Copyright 2017 Chun Shen, Bjoern Schenke, Sangyong Jeon, and Charles Gale
+#include "cell.h"
+
+const ViscousVec Cell_ideal::Wmunu = {0.};
+const double Cell_ideal::pi_b = 0.;
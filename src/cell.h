@@ -6,6 +6,21 @@
 #include <array>
 #include <cmath>
 
+//! Fluid cell for ideal hydrodynamics. It only stores epsilon, rhob and
+//! u^mu (48 bytes instead of 168 for Cell_small); the dissipative fields
+//! are shared read-only zeros, so code reading Wmunu or pi_b works on
+//! both cell types while any attempt to write them fails to compile.
+class Cell_ideal {
+ public:
+    double epsilon = 0;
+    double rhob = 0;
+    FlowVec u = {1., 0., 0., 0.};
+
+    static const ViscousVec Wmunu;
+    static const double pi_b;
+};
+
+
 class Cell_small {
  public:
     double epsilon = 0;
@@ -15,6 +30,19 @@ class Cell_small {
     ViscousVec Wmunu = {0.};
     double pi_b = 0.;
 
+    Cell_small() = default;
+    Cell_small(const Cell_ideal &cell) :
+        epsilon(cell.epsilon), rhob(cell.rhob), u(cell.u) {}
+
+    //! drops the dissipative fields
+    operator Cell_ideal() const {
+        Cell_ideal res;
+        res.epsilon = epsilon;
+        res.rhob    = rhob;
+        res.u       = u;
+        return(res);
+    }
+
 
     Cell_small operator + (Cell_small const &obj) {
         Cell_small res;
@@ -51,6 +79,20 @@ class Cell_small {
 };
 
 
+//! equation-of-state values and conserved densities of a cell at one
+//! Runge-Kutta stage (the primitive cache of Advance)
+class CellThermo {
+ public:
+    double pressure = 0;
+    double T = 0;
+    double cs2 = 0;
+    double muB = 0;
+    double entropy = 0;
+    //! tau*T^{tau mu} (mu < 4) and tau*J^tau (mu = 4)
+    TJbVec tauTJb0 = {0.};
+};
+
+
 class Cell_aux {
  public:
     VorticityVec omega_kSP = {0.};
@@ -43,3 +43,25 @@ TEST_CASE("Does cell * work") {
     CHECK(cell2.rhob == cell1.rhob*factor);
     CHECK(cell2.u[1] == cell1.u[1]*factor);
 }
+
+
+TEST_CASE("Does Cell_ideal conversion work") {
+    Cell_small cell1;
+    cell1.epsilon = 1.0;
+    cell1.rhob = 2.0;
+    cell1.u[1] = 0.2;
+    cell1.Wmunu[3] = 0.2;
+    cell1.pi_b = 0.1;
+
+    Cell_ideal cell2 = cell1;
+    CHECK(cell2.epsilon == cell1.epsilon);
+    CHECK(cell2.rhob == cell1.rhob);
+    CHECK(cell2.u == cell1.u);
+    CHECK(cell2.Wmunu[3] == 0.);
+    CHECK(cell2.pi_b == 0.);
+
+    Cell_small cell3 = cell2;
+    CHECK(cell3.u == cell1.u);
+    CHECK(cell3.Wmunu[3] == 0.);
+    CHECK(sizeof(Cell_ideal) < sizeof(Cell_small));
+}
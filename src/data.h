@@ -80,9 +80,68 @@ typedef struct init_data {
     double delta_eta;
     double delta_tau;
 
+    //! adaptive time step: before every step delta_tau is set from the
+    //! CFL condition with the largest KT signal speed on the grid
+    //! (cfl_number) and from the shortest shear and bulk relaxation time
+    //! (unless semi_implicit_relaxation), capped at delta_tau_max [fm];
+    //! Delta_Tau is the first step (0: fixed)
+    int adaptive_time_step;
+    double cfl_number;
+    double delta_tau_max;
+    //! tau distance between arena_prev and arena_current read by the
+    //! backward time derivatives (delta_tau unless adaptive_time_step)
+    double delta_tau_prev;
+    //! tau spacing of the evolution output, which stays on the grid of the
+    //! initial time step also with adaptive_time_step
+    double delta_tau_output;
+
     int rk_order;
     double minmod_theta;
 
+    //! pin OpenMP thread i to the i-th allowed CPU at startup (1), so the
+    //! arena pages first touched by a thread stay on its NUMA node
+    int omp_thread_affinity;
+
+    //! flag to stream the stencil kernels from a structure-of-arrays
+    //! copy of the current arena (1) or from the SCGrid directly (0)
+    int use_SoA_grid_storage;
+
+    //! flag to compute the KT fluxes pencil by pencil along x with
+    //! vectorized slope limiters (1) or cell by cell (0)
+    int use_pencil_flux_kernel;
+
+    //! flag to compute every KT interface flux once in a face-centred
+    //! pass and difference the stored fluxes per cell (1)
+    int use_face_flux_kernel;
+
+    //! flag to evaluate the EOS and tau*T^{tau mu} once per cell and RK
+    //! stage into a scratch grid read by the flux and source kernels (1)
+    int use_primitive_cache;
+
+    //! flag to allocate the arenas with a 2-cell ghost layer (1), so the
+    //! stencil kernels read neighbours without clamping the indices
+    int use_ghost_cells;
+
+    //! number of cells per brick in x, y and eta for the cache-blocked
+    //! sweep in Advance::AdvanceIt (<= 0: the whole grid in that direction)
+    int brick_size_x;
+    int brick_size_y;
+    int brick_size_eta;
+
+    //! energy density [GeV/fm^3] below which cells far from the fireball
+    //! are treated as vacuum and skipped (0: evolve the whole grid)
+    double active_region_eps_cut;
+
+    //! expanding transverse grid: crop the arenas to a tight box around the
+    //! fireball once the hydro sources are deposited and grow them (at
+    //! fixed cell spacing, up to nx*ny) whenever a cell above
+    //! expanding_grid_eps_cut [GeV/fm^3] comes closer than
+    //! expanding_grid_buffer cells to the edge. nx, ny, x_size and y_size
+    //! stay those of the input grid.
+    int expanding_grid;
+    double expanding_grid_eps_cut;
+    int expanding_grid_buffer;
+
     double sFactor;     //!< overall normalization on energy density profile
     int whichEOS;       //!< type of EoS
     //! flag for boost invariant simulations
@@ -162,6 +221,11 @@ typedef struct init_data {
     //! flag to include vorticity coupling terms in shear and diffusion
     int include_vorticity_terms;
 
+    //! take the relaxation terms of the viscous source terms implicitly
+    //! at the end of every RK stage, so that the relaxation times need
+    //! not be resolved by delta_tau
+    int semi_implicit_relaxation;
+
     //! flag to output vorticity evolution
     int output_vorticity;
 
@@ -25,10 +25,15 @@ Diss::Diss(const EOS &eosIn, const InitData &Data_in) :
 for everywhere else. also, this change is necessary
 to use Wmunu[rk_flag][4][mu] as the dissipative baryon current*/
 /* this is the only one that is being subtracted in the rhs */
+/* GridType is either SCGrid or its structure-of-arrays copy SCGridSoA,
+   with_bulk adds the bulk pressure Pi to W^{mu nu} */
+template <bool with_bulk, class GridType>
 void Diss::MakeWSource(const double tau,
-                       SCGrid &arena_current, SCGrid &arena_prev,
+                       const GridType &arena_current,
+                       const SCGrid &arena_prev,
                        const int ix, const int iy, const int ieta,
                        TJbVec &dwmn) {
+    typedef typename GridType::cell_view CellView;
     /* calculate d_m (tau W^{m,alpha}) + (geom source terms) */
     const auto& grid_pt      = arena_current(ix, iy, ieta);
     const auto& grid_pt_prev = arena_prev(ix, iy, ieta);
@@ -40,6 +45,9 @@ void Diss::MakeWSource(const double tau,
     dwmn = {0.};
     EnergyFlowVec W_eta_p = {0.};  // save tau*W^{\eta \nu} at eta + deta/2
     EnergyFlowVec W_eta_m = {0.};  // save tau*W^{\eta \nu} at eta - deta/2
+    // a boost-invariant grid has no eta neighbours: both eta faces carry
+    // W^{\eta \nu} of the cell itself and the other eta derivatives vanish
+    const int n_direc = DATA.boost_invariant ? 2 : 3;
     for (int alpha = 0; alpha < 5; alpha++) {
         /* partial_tau W^tau alpha */
         /* this is partial_tau evaluated at tau */
@@ -52,24 +60,25 @@ void Diss::MakeWSource(const double tau,
         // dW/dtau
         // backward time derivative (first order is more stable)
         int idx_1d_alpha0 = map_2d_idx_to_1d(alpha, 0);
-        double dWdtau = (grid_pt.Wmunu[idx_1d_alpha0]
-                         - grid_pt_prev.Wmunu[idx_1d_alpha0])/DATA.delta_tau;
+        double dWdtau = ((grid_pt.Wmunu[idx_1d_alpha0]
+                          - grid_pt_prev.Wmunu[idx_1d_alpha0])
+                         /DATA.delta_tau_prev);
 
         /* bulk pressure term */
         double dPidtau = 0.0;
         double Pi_alpha0 = 0.0;
-        if (alpha < 4 && DATA.turn_on_bulk == 1) {
+        if (alpha < 4 && with_bulk) {
             double gfac = (alpha == 0 ? -1.0 : 0.0);
             Pi_alpha0 = grid_pt.pi_b*(gfac + grid_pt.u[alpha]*grid_pt.u[0]);
             dPidtau = ((Pi_alpha0 - grid_pt_prev.pi_b
                                     *(gfac + grid_pt_prev.u[alpha]
                                              *grid_pt_prev.u[0]))
-                       /DATA.delta_tau);
+                       /DATA.delta_tau_prev);
         }
 
         double dWdx  = 0.0;  // partial_i (tau W^{i \alpha})
         double dPidx = 0.0;  // partial_i (tau Pi^{i \alpha})
-        Neighbourloop(arena_current, ix, iy, ieta, NLAMBDAS{
+        Neighbourloop(arena_current, ix, iy, ieta, NLAMBDAS_VIEW(CellView){
             int idx_1d  = map_2d_idx_to_1d(alpha, direction);
             double sg   = c.Wmunu[idx_1d]*tau_fac[direction];
             double sgp1 = p1.Wmunu[idx_1d]*tau_fac[direction];
@@ -85,7 +94,7 @@ void Diss::MakeWSource(const double tau,
                 dWdx += (W_p - W_m)/delta[direction];
             }
 
-            if (alpha < 4 && DATA.turn_on_bulk == 1) {
+            if (alpha < 4 && with_bulk) {
                 double gfac1 = (alpha == (direction) ? 1.0 : 0.0);
                 double bgp1  = (p1.pi_b*(gfac1 + p1.u[alpha]*p1.u[direction])
                                 *tau_fac[direction]);
@@ -104,7 +113,16 @@ void Diss::MakeWSource(const double tau,
                     dPidx += (Pi_p - Pi_m)/delta[direction];
                 }
             }
-        });
+        }, n_direc);
+        if (DATA.boost_invariant && (alpha == 0 || alpha == 3)) {
+            W_eta_p[alpha] = grid_pt.Wmunu[map_2d_idx_to_1d(alpha, 3)];
+            if (with_bulk) {
+                const double gfac1 = (alpha == 3 ? 1.0 : 0.0);
+                W_eta_p[alpha] += (grid_pt.pi_b
+                                   *(gfac1 + grid_pt.u[alpha]*grid_pt.u[3]));
+            }
+            W_eta_m[alpha] = W_eta_p[alpha];
+        }
 
         // partial_m (tau W^mn) = W^0n + tau partial_tau W^mn
         //                        + partial_i(tau W^in)
@@ -151,32 +169,87 @@ void Diss::MakeWSource(const double tau,
     //dwmn[3] += grid_pt.pi_b*(grid_pt.u[0]*grid_pt.u[3]);
 }
 
+template void Diss::MakeWSource<false, SCGrid>(
+    const double, const SCGrid&, const SCGrid&,
+    const int, const int, const int, TJbVec&);
+template void Diss::MakeWSource<true, SCGrid>(
+    const double, const SCGrid&, const SCGrid&,
+    const int, const int, const int, TJbVec&);
+template void Diss::MakeWSource<false, SCGridSoA>(
+    const double, const SCGridSoA&, const SCGrid&,
+    const int, const int, const int, TJbVec&);
+template void Diss::MakeWSource<true, SCGridSoA>(
+    const double, const SCGridSoA&, const SCGrid&,
+    const int, const int, const int, TJbVec&);
+
+void Diss::get_shear_coefficients(const double epsilon,
+                                  const CellThermo &thermo, double &shear,
+                                  double &tau_pi) const {
+    const double T = thermo.T;
+    const double shear_to_s = transport_coeffs_.get_eta_over_s(T, thermo.muB);
+    const double pressure = thermo.pressure;
+    if (DATA.muB_dependent_shear_to_s == 0) {
+        double entropy = thermo.entropy;
+        shear = shear_to_s*entropy;
+    } else {
+        shear = shear_to_s*(epsilon + pressure)/std::max(T, small_eps);
+    }
+    tau_pi = (transport_coeffs_.get_shear_relax_time_factor()
+              *shear/std::max(epsilon + pressure, small_eps));
+}
+
+
+void Diss::get_bulk_coefficients(const double epsilon,
+                                 const CellThermo &thermo, double &bulk,
+                                 double &Bulk_Relax_time) const {
+    const double temperature = thermo.T;
+    const double cs2 = thermo.cs2;
+    const double pressure = thermo.pressure;
+
+    // T dependent bulk viscosity
+    bulk = transport_coeffs_.get_zeta_over_s(temperature);
+    bulk = bulk*(epsilon + pressure)/temperature;
+
+    // defining bulk relaxation time and additional transport coefficients
+    // Bulk relaxation time from kinetic theory
+    double csfactor = std::max(1./3. - cs2, small_eps);
+    Bulk_Relax_time = (transport_coeffs_.get_bulk_relax_time_factor()
+                       /(csfactor*csfactor)
+                       /std::max(epsilon + pressure, small_eps)*bulk);
+    if (DATA.bulk_relaxation_type == 1) {
+        Bulk_Relax_time = (
+                bulk/(transport_coeffs_.get_bulk_relax_time_factor()
+                      *csfactor)
+                /std::max(epsilon + pressure, small_eps));
+    }
+}
+
+
+double Diss::limit_relaxation_time(const double relax_time,
+                                   const bool implicit) const {
+    const double lower = implicit ? small_eps : 3.*DATA.delta_tau;
+    return(std::min(10., std::max(lower, relax_time)));
+}
+
+
 double Diss::Make_uWSource(const double tau, const Cell_small *grid_pt,
                            const Cell_small *grid_pt_prev,
+                           const CellThermo &thermo,
                            const int mu, const int nu,
                            const int rk_flag, const double theta_local,
                            const DumuVec &a_local,
                            const VelocityShearVec &sigma_1d,
-                           const VorticityVec &omega_1d) {
+                           const VorticityVec &omega_1d,
+                           double *relaxation_rate) {
     double tempf;
-    double SW, shear, T, epsilon, rhob;
+    double SW, shear;
     double NS_term;
 
     auto sigma = Util::UnpackVecToMatrix(sigma_1d);
     auto Wmunu = Util::UnpackVecToMatrix(grid_pt->Wmunu);
 
-    if (rk_flag == 0) {
-        epsilon = grid_pt->epsilon;
-        rhob = grid_pt->rhob;
-    } else {
-        epsilon = grid_pt_prev->epsilon;
-        rhob = grid_pt_prev->rhob;
-    }
-
-    T = eos.get_temperature(epsilon, rhob);
-    double muB = eos.get_muB(epsilon, rhob);
-
-    double shear_to_s = transport_coeffs_.get_eta_over_s(T, muB);
+    const double epsilon = (rk_flag == 0) ? grid_pt->epsilon
+                                          : grid_pt_prev->epsilon;
 
     bool include_WWterm = false;
     bool include_Wsigma_term = false;
@@ -190,16 +263,12 @@ double Diss::Make_uWSource(const double tau, const Cell_small *grid_pt,
     //                Defining transport coefficients                     //
     ////////////////////////////////////////////////////////////////////////
     ////////////////////////////////////////////////////////////////////////
-    double pressure = eos.get_pressure(epsilon, rhob);
-    if (DATA.muB_dependent_shear_to_s == 0) {
-        double entropy = eos.get_entropy(epsilon, rhob);
-        shear = shear_to_s*entropy;
-    } else {
-        shear = shear_to_s*(epsilon + pressure)/std::max(T, small_eps);
-    }
-    double tau_pi = (transport_coeffs_.get_shear_relax_time_factor()
-                     *shear/std::max(epsilon + pressure, small_eps));
-    tau_pi = std::min(10., std::max(3.*DATA.delta_tau, tau_pi));
+    double tau_pi;
+    get_shear_coefficients(epsilon, thermo, shear, tau_pi);
+    tau_pi = limit_relaxation_time(tau_pi, relaxation_rate != nullptr);
+    // the -Wmunu/tau_pi part is left to the caller if it takes the
+    // relaxation implicitly
+    const double relaxation = (relaxation_rate == nullptr) ? 1. : 0.;
 
     // transport coefficient for nonlinear terms -- shear only terms
     // transport coefficients of a massless gas of single component particles
@@ -230,7 +299,8 @@ double Diss::Make_uWSource(const double tau, const Cell_small *grid_pt,
     ////////////////////////////////////////////////////////////////////////
 
     // full term is
-    tempf = (-(1.0 + transport_coefficient2*theta_local)*(Wmunu[mu][nu]));
+    tempf = (-(relaxation + transport_coefficient2*theta_local)
+             *(Wmunu[mu][nu]));
 
     /////////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////
@@ -361,6 +431,9 @@ double Diss::Make_uWSource(const double tau, const Cell_small *grid_pt,
     // final answer is
     SW = (NS_term + tempf + Vorticity_term + Wsigma_term + WW_term
           + Coupling_to_Bulk)/(tau_pi);
+    if (relaxation_rate != nullptr) {
+        *relaxation_rate = 1./tau_pi;
+    }
     return(SW);
 }
 
@@ -396,6 +469,8 @@ int Diss::Make_uWRHS(const double tau, SCGrid &arena,
     const double delta_tau = DATA.delta_tau;
 
     // pi^\mu\nu is symmetric
+    // the eta fluxes of a boost-invariant grid cancel
+    const int n_direc = DATA.boost_invariant ? 2 : 3;
     Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
         int idx_1d = map_2d_idx_to_1d(mu, nu);
         double sum = 0.0;
@@ -451,7 +526,7 @@ int Diss::Make_uWRHS(const double tau, SCGrid &arena,
         sum += -HW;
 
         w_rhs += sum*delta_tau;
-    });
+    }, n_direc);
 
     /* add a source term -u^tau Wmn/tau
        due to the coordinate change to tau-eta */
@@ -521,6 +596,8 @@ int Diss::Make_uPRHS(const double tau, SCGrid &arena,
     delta[3] = DATA.delta_eta*tau;
 
     double sum = 0.0;
+    // the eta fluxes of a boost-invariant grid cancel
+    const int n_direc = DATA.boost_invariant ? 2 : 3;
     Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
         /* Get_uPis */
         double g = c.pi_b;
@@ -578,7 +655,7 @@ int Diss::Make_uPRHS(const double tau, SCGrid &arena,
 
         /* make partial_i (u^i Pi) */
         sum += -HPi;
-    });
+    }, n_direc);
 
      /* add a source term due to the coordinate change to tau-eta */
      sum -= (grid_pt->pi_b)*(grid_pt->u[0])/tau;
@@ -590,9 +667,11 @@ int Diss::Make_uPRHS(const double tau, SCGrid &arena,
 
 
 double Diss::Make_uPiSource(const double tau, const Cell_small *grid_pt,
-                            const Cell_small *grid_pt_prev, 
+                            const Cell_small *grid_pt_prev,
+                            const CellThermo &thermo,
                             const int rk_flag, const double theta_local,
-                            const VelocityShearVec &sigma_1d) {
+                            const VelocityShearVec &sigma_1d,
+                            double *relaxation_rate) {
     double tempf;
     double bulk;
     double Bulk_Relax_time;
@@ -609,47 +688,19 @@ double Diss::Make_uPiSource(const double tau, const Cell_small *grid_pt,
         include_coupling_to_shear = 1;
     }
 
-    double epsilon, rhob;
-    if (rk_flag == 0) {
-        epsilon = grid_pt->epsilon;
-        rhob = grid_pt->rhob;
-    } else {
-        epsilon = grid_pt_prev->epsilon;
-        rhob = grid_pt_prev->rhob;
-    }
-
-    // defining bulk viscosity coefficient
-
-    // shear viscosity = constant * entropy density
-    //s_den = eos.get_entropy(epsilon, rhob);
-    //shear = (DATA.shear_to_s)*s_den;   
-    // shear viscosity = constant * (e + P)/T
-    double temperature = eos.get_temperature(epsilon, rhob);
+    const double epsilon = (rk_flag == 0) ? grid_pt->epsilon
+                                          : grid_pt_prev->epsilon;
 
     // cs2 is the velocity of sound squared
-    double cs2 = eos.get_cs2(epsilon, rhob);
-    double pressure = eos.get_pressure(epsilon, rhob);
+    double cs2 = thermo.cs2;
 
-    // T dependent bulk viscosity
-    bulk = transport_coeffs_.get_zeta_over_s(temperature);
-    bulk = bulk*(epsilon + pressure)/temperature;
-
-    // defining bulk relaxation time and additional transport coefficients
-    // Bulk relaxation time from kinetic theory
-    double csfactor = std::max(1./3. - cs2, small_eps);
-    Bulk_Relax_time = (transport_coeffs_.get_bulk_relax_time_factor()
-                       /(csfactor*csfactor)
-                       /std::max(epsilon + pressure, small_eps)*bulk);
-    if (DATA.bulk_relaxation_type == 1) {
-        Bulk_Relax_time = (
-                bulk/(transport_coeffs_.get_bulk_relax_time_factor()
-                      *csfactor)
-                /std::max(epsilon + pressure, small_eps));
-    }
+    // defining bulk viscosity coefficient and relaxation time
+    get_bulk_coefficients(epsilon, thermo, bulk, Bulk_Relax_time);
 
     // avoid overflow or underflow of the bulk relaxation time
-    Bulk_Relax_time = (
-        std::min(10., std::max(3.*DATA.delta_tau, Bulk_Relax_time)));
+    Bulk_Relax_time = limit_relaxation_time(Bulk_Relax_time,
+                                            relaxation_rate != nullptr);
+    const double relaxation = (relaxation_rate == nullptr) ? 1. : 0.;
 
     // from kinetic theory, small mass limit
     transport_coeff1   = (
@@ -668,7 +719,7 @@ double Diss::Make_uPiSource(const double tau, const Cell_small *grid_pt,
 
     // Computing relaxation term and nonlinear term:
     // - Bulk - transport_coeff1*Bulk*theta
-    tempf = (-(grid_pt->pi_b)
+    tempf = (-relaxation*(grid_pt->pi_b)
              - transport_coeff1*theta_local*(grid_pt->pi_b));
 
     // Computing nonlinear term: + transport_coeff2*Bulk*Bulk
@@ -719,6 +770,9 @@ double Diss::Make_uPiSource(const double tau, const Cell_small *grid_pt,
 
     // Final Answer
     Final_Answer = NS_term + tempf + BB_term + Coupling_to_Shear;
+    if (relaxation_rate != nullptr) {
+        *relaxation_rate = 1./Bulk_Relax_time;
+    }
 
     return Final_Answer/(Bulk_Relax_time);
 }/* Make_uPiSource */
@@ -738,9 +792,10 @@ double Diss::Make_uPiSource(const double tau, const Cell_small *grid_pt,
 */
 double Diss::Make_uqSource(
     const double tau, const Cell_small *grid_pt, const Cell_small *grid_pt_prev,
-    const int nu, const int rk_flag, const double theta_local,
+    const CellThermo &thermo, const int nu, const int rk_flag, const double theta_local,
     const DumuVec &a_local, const VelocityShearVec &sigma_1d,
-    const VorticityVec &omega_1d, const DmuMuBoverTVec &baryon_diffusion_vec) {
+    const VorticityVec &omega_1d, const DmuMuBoverTVec &baryon_diffusion_vec,
+    double *relaxation_rate) {
 
     double epsilon, rhob;
     if (rk_flag == 0) {
@@ -750,14 +805,18 @@ double Diss::Make_uqSource(
         epsilon = grid_pt_prev->epsilon;
         rhob = grid_pt_prev->rhob;
     }
-    double pressure = eos.get_pressure(epsilon, rhob);
-    double T        = eos.get_temperature(epsilon, rhob);
+    double pressure = thermo.pressure;
+    double T        = thermo.T;
 
     double kappa_coefficient = DATA.kappa_coefficient;
     double tau_rho = kappa_coefficient/std::max(T, small_eps);
-    tau_rho = std::min(10., std::max(3.*DATA.delta_tau, tau_rho));
+    tau_rho = limit_relaxation_time(tau_rho, relaxation_rate != nullptr);
+    const double relaxation = (relaxation_rate == nullptr) ? 1. : 0.;
+    if (relaxation_rate != nullptr) {
+        *relaxation_rate = 1./tau_rho;
+    }
 
-    double mub   = eos.get_muB(epsilon, rhob);
+    double mub   = thermo.muB;
     double alpha = mub/std::max(T, small_eps);
     double denorm_safe = std::copysign(
             std::max(std::abs(3.*T*tanh(alpha)), small_eps), 3.*T*tanh(alpha));
@@ -820,10 +879,11 @@ double Diss::Make_uqSource(
         Nonlinear3 = -transport_coeff_3*temp3;
     }
 
-    double SW = (-q[nu] - NS + Nonlinear1 + Nonlinear2 + Nonlinear3)/tau_rho;
+    double SW = (-relaxation*q[nu] - NS + Nonlinear1 + Nonlinear2
+                 + Nonlinear3)/tau_rho;
     if (DATA.Initial_profile == 1) {
         // for 1+1D numerical test
-        SW = (-q[nu] - NS)/tau_rho;
+        SW = (-relaxation*q[nu] - NS)/tau_rho;
     }
 
     // all other geometric terms....
@@ -884,6 +944,8 @@ double Diss::Make_uqRHS(const double tau, SCGrid &arena,
     // we use the Wmunu[4][nu] = q[nu]
     int idx_1d = map_2d_idx_to_1d(mu, nu);
     double sum = 0.0;
+    // the eta fluxes of a boost-invariant grid cancel
+    const int n_direc = DATA.boost_invariant ? 2 : 3;
     Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
         /* Get_uWmns */
         double g = c.Wmunu[idx_1d];
@@ -934,7 +996,7 @@ double Diss::Make_uqRHS(const double tau, SCGrid &arena,
         double HW = (HWph - HWmh)/delta[direction];
         /* make partial_i (u^i Wmn) */
         sum += -HW;
-    });
+    }, n_direc);
 
     /* add a source term -u^tau Wmn/tau due to the coordinate 
      * change to tau-eta */
@@ -30,17 +30,41 @@ class Diss {
 
  public:
     Diss(const EOS &eosIn, const InitData &DATA_in);
+    template <bool with_bulk, class GridType>
     void MakeWSource(const double tau,
-                     SCGrid &arena_current, SCGrid &arena_prev,
+                     const GridType &arena_current, const SCGrid &arena_prev,
                      const int ix, const int iy, const int ieta,
                      TJbVec &dwmn);
 
+    //! shear viscosity and relaxation time tau_pi of a cell with energy
+    //! density epsilon, before Make_uWSource limits it with
+    //! limit_relaxation_time
+    void get_shear_coefficients(const double epsilon,
+                                const CellThermo &thermo, double &shear,
+                                double &tau_pi) const;
+
+    //! bulk viscosity and relaxation time, as used in Make_uPiSource
+    void get_bulk_coefficients(const double epsilon,
+                               const CellThermo &thermo, double &bulk,
+                               double &Bulk_Relax_time) const;
+
+    //! relaxation time limited to at most 10 fm and, unless the
+    //! relaxation term is taken implicitly, to at least 3 delta_tau
+    double limit_relaxation_time(const double relax_time,
+                                 const bool implicit) const;
+
+    //! the source terms take the thermodynamics of grid_pt (rk_flag = 0)
+    //! or grid_pt_prev (rk_flag = 1) from thermo. With relaxation_rate
+    //! they leave out the relaxation term -X/tau_X and return 1/tau_X in
+    //! it instead, for the implicit update of semi_implicit_relaxation
     double Make_uWSource(const double tau, const Cell_small *grid_pt,
                          const Cell_small *grid_pt_prev,
+                         const CellThermo &thermo,
                          const int mu, const int nu, const int rk_flag,
                          const double theta_local, const DumuVec &a_local,
                          const VelocityShearVec &sigma_1d,
-                         const VorticityVec &omega_1d);
+                         const VorticityVec &omega_1d,
+                         double *relaxation_rate = nullptr);
 
     int Make_uWRHS(const double tau, SCGrid &arena,
                    const int ix, const int iy, const int ieta,
@@ -52,9 +76,11 @@ class Diss {
                    double *p_rhs, const double theta_local);
 
     double Make_uPiSource(const double tau, const Cell_small *grid_pt,
-                          const Cell_small *grid_pt_prev, const int rk_flag,
+                          const Cell_small *grid_pt_prev,
+                          const CellThermo &thermo, const int rk_flag,
                           const double theta_local,
-                          const VelocityShearVec &sigma_1d);
+                          const VelocityShearVec &sigma_1d,
+                          double *relaxation_rate = nullptr);
 
     double Make_uqRHS(const double tau, SCGrid &arena_current,
                       const int ix, const int iy, const int ieta,
@@ -62,11 +88,12 @@ class Diss {
 
     double Make_uqSource(const double tau, const Cell_small *grid_pt,
                          const Cell_small *grid_pt_prev,
-                         const int nu, const int rk_flag,
+                         const CellThermo &thermo, const int nu, const int rk_flag,
                          const double theta_local, const DumuVec &a_local,
                          const VelocityShearVec &sigma_1d,
                          const VorticityVec &omega_1d,
-                         const DmuMuBoverTVec &baryon_diffusion_vec);
+                         const DmuMuBoverTVec &baryon_diffusion_vec,
+                         double *relaxation_rate = nullptr);
 
     void output_kappa_T_and_muB_dependence();
     void output_kappa_along_const_sovernB();
@@ -15,6 +15,7 @@
 EOS::EOS(const int eos_id_in) : eos_id(eos_id_in)  {
     if (eos_id == 0) {
         eos_ptr = std::unique_ptr<EOS_idealgas> (new EOS_idealgas ());
+        eos_type = EOSType::idealgas;
     } else if (eos_id == 1) {
         eos_ptr = std::unique_ptr<EOS_eosQ> (new EOS_eosQ ());
     } else if (eos_id >= 2 && eos_id <= 7) {
@@ -25,6 +26,7 @@ EOS::EOS(const int eos_id_in) : eos_id(eos_id_in)  {
         eos_ptr = std::unique_ptr<EOS_hotQCD> (new EOS_hotQCD (eos_id));
     } else if (eos_id >= 10 && eos_id <= 15) {
         eos_ptr = std::unique_ptr<EOS_neos> (new EOS_neos (eos_id));
+        eos_type = EOSType::neos;
     } else if (eos_id == 17) {
         eos_ptr = std::unique_ptr<EOS_BEST> (new EOS_BEST ());
     } else if (eos_id == 19) {
@@ -4,29 +4,99 @@
 #define SRC_EOS_H_
 
 #include "eos_base.h"
+#include "eos_idealgas.h"
+#include "eos_neos.h"
 #include <memory>
 
 //! This is a wrapper class for the equation of state
+//! The ideal gas and neos are called through their concrete (final) types,
+//! picked once in the constructor. So the calls in the hydro kernels are
+//! direct, and the ideal gas functions are inlined. The other EoSs go
+//! through the virtual functions of EOS_base.
 class EOS {
  private:
     const int eos_id;
 
     std::unique_ptr<EOS_base> eos_ptr;
 
+    enum class EOSType {base, idealgas, neos};
+    EOSType eos_type = EOSType::base;
+
+    const EOS_idealgas &idealgas() const {
+        return(static_cast<const EOS_idealgas&>(*eos_ptr));
+    }
+    const EOS_neos &neos() const {
+        return(static_cast<const EOS_neos&>(*eos_ptr));
+    }
+
  public:
     EOS() = default;
     EOS(const int eos_id_in);
 
     ~EOS() {};
 
+    // the hot functions, dispatched on eos_type
+    double get_pressure(double e, double rhob) const {
+        switch (eos_type) {
+            case EOSType::idealgas: return(idealgas().get_pressure(e, rhob));
+            case EOSType::neos:     return(neos().get_pressure(e, rhob));
+            default:                return(eos_ptr->get_pressure(e, rhob));
+        }
+    }
+    double get_temperature(double e, double rhob) const {
+        switch (eos_type) {
+            case EOSType::idealgas: return(idealgas().get_temperature(e, rhob));
+            case EOSType::neos:     return(neos().get_temperature(e, rhob));
+            default:                return(eos_ptr->get_temperature(e, rhob));
+        }
+    }
+    double get_cs2(double e, double rhob) const {
+        switch (eos_type) {
+            case EOSType::idealgas: return(idealgas().get_cs2(e, rhob));
+            case EOSType::neos:     return(neos().get_cs2(e, rhob));
+            default:                return(eos_ptr->get_cs2(e, rhob));
+        }
+    }
+    double get_dpde(double e, double rhob) const {
+        switch (eos_type) {
+            case EOSType::idealgas: return(idealgas().p_e_func(e, rhob));
+            case EOSType::neos:     return(neos().p_e_func(e, rhob));
+            default:                return(eos_ptr->p_e_func(e, rhob));
+        }
+    }
+    double get_dpdrhob(double e, double rhob) const {
+        switch (eos_type) {
+            case EOSType::idealgas: return(idealgas().p_rho_func(e, rhob));
+            case EOSType::neos:     return(neos().p_rho_func(e, rhob));
+            default:                return(eos_ptr->p_rho_func(e, rhob));
+        }
+    }
+    double get_muB(double e, double rhob) const {
+        switch (eos_type) {
+            case EOSType::idealgas: return(idealgas().get_muB(e, rhob));
+            case EOSType::neos:     return(neos().get_muB(e, rhob));
+            default:                return(eos_ptr->get_muB(e, rhob));
+        }
+    }
+    //! pressure, T, muB, muS, muC, entropy and (with_cs2) cs2 in one query
+    EOSThermo get_thermo(double e, double rhob, bool with_cs2=true) const {
+        switch (eos_type) {
+            case EOSType::idealgas:
+                return(idealgas().get_thermo(e, rhob, with_cs2));
+            case EOSType::neos:
+                return(neos().get_thermo(e, rhob, with_cs2));
+            default:
+                return(eos_ptr->get_thermo(e, rhob, with_cs2));
+        }
+    }
+    //! pressure at the n points (epsilon[i], rhob[i])
+    void get_pressure_batch(const int n, const double *epsilon,
+                            const double *rhob, double *p) const {
+        eos_ptr->get_pressure_batch(n, epsilon, rhob, p);
+    }
+
     // functions to call the function pointers
-    double get_pressure   (double e, double rhob) const {return(eos_ptr->get_pressure(e, rhob));}
-    double get_temperature(double e, double rhob) const {return(eos_ptr->get_temperature(e, rhob));}
     double get_entropy    (double e, double rhob) const {return(eos_ptr->get_entropy(e, rhob));}
-    double get_cs2        (double e, double rhob) const {return(eos_ptr->get_cs2(e, rhob));}
-    double get_dpde       (double e, double rhob) const {return(eos_ptr->p_e_func(e, rhob));}
-    double get_dpdrhob    (double e, double rhob) const {return(eos_ptr->p_rho_func(e, rhob));}
-    double get_muB        (double e, double rhob) const {return(eos_ptr->get_muB(e, rhob));}
     double get_muS        (double e, double rhob) const {return(eos_ptr->get_muS(e, rhob));}
     double get_muC        (double e, double rhob) const {return(eos_ptr->get_muC(e, rhob));}
     double get_s2e        (double s, double rhob) const {return(eos_ptr->get_s2e(s, rhob));}
@@ -34,6 +104,9 @@ class EOS {
 
     double get_eps_max() const {return(eos_ptr->get_eps_max());}
     void   check_eos()   const {return(eos_ptr->check_eos());}
+    void   benchmark_eos(const int n_queries) const {
+        eos_ptr->benchmark_eos(n_queries);
+    }
 };
 
 #endif  // SRC_EOS_H_
@@ -100,6 +100,7 @@ void EOS_UH::initialize_eos() {
 
     double eps_max_in = e_bounds[5] + e_spacing[5]*e_length[5];
     set_eps_max(eps_max_in);
+    build_table_idx_map();
 
     music_message.info("Done reading EOS.");
 }
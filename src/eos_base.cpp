@@ -2,11 +2,21 @@
 #include "eos_base.h"
 #include "util.h"
 
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
 #include <string>
 #include <sstream>
 #include <iomanip>
 #include <fstream>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 using std::ostringstream;
 using std::setw;
 using std::setprecision;
@@ -20,15 +30,29 @@ using Util::small_eps;
 
 EOS_base::~EOS_base() {
     for (int itable = 0; itable < number_of_tables; itable++) {
-        Util::mtx_free(pressure_tb[itable],
-                       nb_length[itable], e_length[itable]);
-        Util::mtx_free(temperature_tb[itable],
-                       nb_length[itable], e_length[itable]);
+        free_table(pressure_tb[itable], itable);
+        free_table(temperature_tb[itable], itable);
     }
     if (number_of_tables > 0) {
         delete[] pressure_tb;
         delete[] temperature_tb;
     }
+    if (mapped_tables != nullptr) {
+        munmap(mapped_tables, mapped_size);
+    } else {
+        free(interleaved_tb);
+    }
+}
+
+
+//! This function frees one table of the sub-table itable; the values of
+//! the tables mapped from the binary cache belong to the mapping
+void EOS_base::free_table(double **table, const int itable) {
+    if (mapped_tables != nullptr) {
+        delete[] table;
+    } else {
+        Util::mtx_free(table, nb_length[itable], e_length[itable]);
+    }
 }
 
 
@@ -72,6 +96,14 @@ double EOS_base::interpolate2D(const double e, const double rhob,
 //        P(e, rho_b), T(e, rho_b), s(e, rho_b), mu_b(e, rho_b)
 // as two-dimensional arrays on an equally spacing lattice grid
 // units: e is in 1/fm^4, rhob is in 1/fm^3
+    return(interpolate2D(get_stencil2D(e, rhob, table_idx), table));
+}
+
+
+//! This function returns the indices and weights of interpolate2D, so that
+//! several tables can be interpolated at the same (e, rhob)
+EOS_base::Stencil2D EOS_base::get_stencil2D(const double e, const double rhob,
+                                            const int table_idx) const {
     //double local_ed = e*hbarc;  // [GeV/fm^3]
     double local_ed = e;        // [1/fm^4]
     double local_nb = rhob;     // [1/fm^3]
@@ -98,22 +130,41 @@ double EOS_base::interpolate2D(const double e, const double rhob,
     idx_e  = std::max(0, idx_e);
     idx_nb = std::max(0, idx_nb);
 
-    double frac_e    = (local_ed - (idx_e*delta_e + e0))/delta_e;
-    double frac_rhob = (local_nb - (idx_nb*delta_nb + nb0))/delta_nb;
+    Stencil2D stencil;
+    stencil.table_idx = table_idx;
+    stencil.idx_e     = idx_e;
+    stencil.idx_nb    = idx_nb;
+    stencil.frac_e    = (local_ed - (idx_e*delta_e + e0))/delta_e;
+    stencil.frac_rhob = (local_nb - (idx_nb*delta_nb + nb0))/delta_nb;
     // avoid uncontrolled extrapolation at large net baryon density
-    frac_rhob = std::min(1., frac_rhob);
+    stencil.frac_rhob = std::min(1., stencil.frac_rhob);
+    return(stencil);
+}
+
+
+double EOS_base::interpolate2D(const Stencil2D &stencil,
+                               double ***table) const {
+    const int table_idx = stencil.table_idx;
+    const int idx_e     = stencil.idx_e;
+    const int idx_nb    = stencil.idx_nb;
+    const double frac_e    = stencil.frac_e;
+    const double frac_rhob = stencil.frac_rhob;
+    const int N_e = e_length[table_idx];
+
+    const double *tb = table[table_idx][0];
+    const int idx    = idx_nb*N_e + idx_e;
 
     double result;
-    double temp1 = table[table_idx][idx_nb][idx_e];
-    double temp4 = table[table_idx][idx_nb + 1][idx_e];
+    double temp1 = tb[idx];
+    double temp4 = tb[idx + N_e];
     double temp2 = 0.;
     double temp3 = 0;
     if (idx_e == N_e - 1) {
         temp2 = table[table_idx + 1][idx_nb][0];
         temp3 = table[table_idx + 1][idx_nb][0];
     } else {
-        temp2 = table[table_idx][idx_nb][idx_e + 1];
-        temp3 = table[table_idx][idx_nb + 1][idx_e + 1];
+        temp2 = tb[idx + 1];
+        temp3 = tb[idx + N_e + 1];
     }
     result = ((temp1*(1. - frac_e) + temp2*frac_e)*(1. - frac_rhob)
               + (temp3*frac_e + temp4*(1. - frac_e))*frac_rhob);
@@ -121,6 +172,126 @@ double EOS_base::interpolate2D(const double e, const double rhob,
 }
 
 
+//! This function copies the tables into one block with the values of all
+//! tables at a node next to each other. It has to be called after the
+//! tables are read in.
+void EOS_base::build_interleaved_table(
+                                const std::vector<double***> &tables) {
+    if (mapped_tables == nullptr) free(interleaved_tb);
+    const long size = set_interleaved_offsets(
+                                    static_cast<int>(tables.size()));
+    void *block = nullptr;
+    if (posix_memalign(&block, 64, std::max(1L, size)*sizeof(double)) != 0) {
+        music_message.error("Can not allocate the interleaved EoS table.");
+        exit(1);
+    }
+    interleaved_tb = static_cast<double*>(block);
+    for (int itable = 0; itable < number_of_tables; itable++) {
+        double *node = interleaved_tb + interleaved_offset[itable];
+        for (int i = 0; i < nb_length[itable]; i++) {
+            for (int j = 0; j < e_length[itable]; j++) {
+                for (int q = 0; q < n_interleaved; q++)
+                    node[q] = tables[q][itable][i][j];
+                node += n_interleaved;
+            }
+        }
+    }
+}
+
+
+//! This function sets n_interleaved and the offsets of the tables in the
+//! interleaved block, it returns the size of the block in doubles
+long EOS_base::set_interleaved_offsets(const int n_quantities) {
+    n_interleaved = n_quantities;
+    interleaved_offset.resize(number_of_tables);
+    long size = 0;
+    for (int itable = 0; itable < number_of_tables; itable++) {
+        interleaved_offset[itable] = size;
+        size += (static_cast<long>(nb_length[itable])*e_length[itable]
+                 *n_interleaved);
+    }
+    return(size);
+}
+
+
+//! This function interpolates all quantities of the interleaved table at
+//! the stencil, the results are the same as interpolate2D for each table
+void EOS_base::interpolate2D_interleaved(const Stencil2D &stencil,
+                                         double *values) const {
+    const int table_idx = stencil.table_idx;
+    const int idx_e     = stencil.idx_e;
+    const int idx_nb    = stencil.idx_nb;
+    const double frac_e    = stencil.frac_e;
+    const double frac_rhob = stencil.frac_rhob;
+    const int N_e = e_length[table_idx];
+    const int nq  = n_interleaved;
+
+    const double *tb = interleaved_tb + interleaved_offset[table_idx];
+    const double *node1 = tb + (idx_nb*N_e + idx_e)*nq;
+    const double *node4 = node1 + N_e*nq;
+    const double *node2 = node1 + nq;
+    const double *node3 = node4 + nq;
+    if (idx_e == N_e - 1) {
+        node2 = (interleaved_tb + interleaved_offset[table_idx + 1]
+                 + idx_nb*e_length[table_idx + 1]*nq);
+        node3 = node2;
+    }
+    for (int q = 0; q < nq; q++) {
+        values[q] = ((node1[q]*(1. - frac_e) + node2[q]*frac_e)*(1. - frac_rhob)
+                     + (node3[q]*frac_e + node4[q]*(1. - frac_e))*frac_rhob);
+    }
+}
+
+
+//! This function is interpolate2D at n points (e[i], rhob[i]). The stencils
+//! are looked up one by one, the interpolation of a chunk of points is a
+//! vectorized loop.
+void EOS_base::interpolate2D_batch(const int n, const double *e,
+                                   const double *rhob, double ***table,
+                                   double *results) const {
+    const int chunk = 64;
+    double temp1[chunk], temp2[chunk], temp3[chunk], temp4[chunk];
+    double frac_e[chunk], frac_rhob[chunk];
+    for (int i0 = 0; i0 < n; i0 += chunk) {
+        const int m = std::min(chunk, n - i0);
+        for (int i = 0; i < m; i++) {
+            const Stencil2D stencil = get_stencil2D(
+                e[i0 + i], rhob[i0 + i], get_table_idx(e[i0 + i]));
+            const int table_idx = stencil.table_idx;
+            const int N_e = e_length[table_idx];
+            const double *tb = table[table_idx][0];
+            const int idx = stencil.idx_nb*N_e + stencil.idx_e;
+            temp1[i] = tb[idx];
+            temp4[i] = tb[idx + N_e];
+            if (stencil.idx_e == N_e - 1) {
+                temp2[i] = table[table_idx + 1][stencil.idx_nb][0];
+                temp3[i] = temp2[i];
+            } else {
+                temp2[i] = tb[idx + 1];
+                temp3[i] = tb[idx + N_e + 1];
+            }
+            frac_e[i]    = stencil.frac_e;
+            frac_rhob[i] = stencil.frac_rhob;
+        }
+        double *res = results + i0;
+        #pragma omp simd
+        for (int i = 0; i < m; i++) {
+            res[i] = ((temp1[i]*(1. - frac_e[i]) + temp2[i]*frac_e[i])
+                      *(1. - frac_rhob[i])
+                      + (temp3[i]*frac_e[i] + temp4[i]*(1. - frac_e[i]))
+                        *frac_rhob[i]);
+        }
+    }
+}
+
+
+void EOS_base::get_pressure_batch(const int n, const double *epsilon,
+                                  const double *rhob, double *p) const {
+    for (int i = 0; i < n; i++)
+        p[i] = get_pressure(epsilon[i], rhob[i]);
+}
+
+
 //! This function returns entropy density in [1/fm^3]
 //! The input local energy density e [1/fm^4], rhob[1/fm^3]
 double EOS_base::get_entropy(double epsilon, double rhob) const {
@@ -136,6 +307,32 @@ double EOS_base::get_entropy(double epsilon, double rhob) const {
 }
 
 
+//! This function returns entropy density in [1/fm^3] from the pressure,
+//! temperature and chemical potentials in thermo
+double EOS_base::get_entropy(const double epsilon, const double rhob,
+                             const EOSThermo &thermo) const {
+    auto rhoS = get_rhoS(epsilon, rhob);
+    auto rhoC = get_rhoC(epsilon, rhob);
+    auto f    = (epsilon + thermo.pressure - thermo.muB*rhob
+                 - thermo.muS*rhoS - thermo.muC*rhoC)/(thermo.T + small_eps);
+    return(std::max(small_eps, f));
+}
+
+
+EOSThermo EOS_base::get_thermo(double e, double rhob,
+                               bool with_cs2) const {
+    EOSThermo thermo;
+    thermo.pressure = get_pressure(e, rhob);
+    thermo.T        = get_temperature(e, rhob);
+    thermo.muB      = get_muB(e, rhob);
+    thermo.muS      = get_muS(e, rhob);
+    thermo.muC      = get_muC(e, rhob);
+    if (with_cs2) thermo.cs2 = get_cs2(e, rhob);
+    thermo.entropy  = get_entropy(e, rhob, thermo);
+    return(thermo);
+}
+
+
 double EOS_base::get_cs2(double e, double rhob) const {
     double f = calculate_velocity_of_sound_sq(e, rhob);
     return(f);
@@ -143,11 +340,16 @@ double EOS_base::get_cs2(double e, double rhob) const {
 
 
 double EOS_base::calculate_velocity_of_sound_sq(double e, double rhob) const {
+    return(calculate_velocity_of_sound_sq(e, rhob, get_pressure(e, rhob)));
+}
+
+
+double EOS_base::calculate_velocity_of_sound_sq(double e, double rhob,
+                                                double pressure) const {
     double v_min = 0.01;
     double v_max = 1./3;
     double dpde = p_e_func(e, rhob);
     double dpdrho = p_rho_func(e, rhob);
-    double pressure = get_pressure(e, rhob);
     double v_sound = dpde + rhob/(e + pressure + small_eps)*dpdrho;
     v_sound = std::max(v_min, std::min(v_max, v_sound));
     return(v_sound);
@@ -182,15 +384,53 @@ double EOS_base::get_dpOverdrhob2(double e, double rhob) const {
 }
 
 
+//! This function builds the map from the leading bits of e to the table
+//! ids. It has to be called after the table bounds are read in. The bits of
+//! a positive double are ordered like its value, so the id stored for a key
+//! is the table of the smallest e with that key and at most the bounds
+//! falling inside the key have to be checked at the lookup. With up to two
+//! tables the scan is a single comparison and is kept.
+void EOS_base::build_table_idx_map() {
+    table_idx_map.clear();
+    if (number_of_tables <= 2 || !(e_bounds[1] > 0.)) return;
+    for (int itable = 2; itable < number_of_tables; itable++) {
+        // the lookup relies on increasing bounds
+        if (!(e_bounds[itable] > e_bounds[itable - 1])) return;
+    }
+    table_key_min = get_table_key(e_bounds[1]);
+    const uint64_t key_max = get_table_key(e_bounds[number_of_tables - 1]);
+    table_idx_map.resize(key_max - table_key_min + 1);
+    int itable = 0;
+    for (uint64_t key = table_key_min; key <= key_max; key++) {
+        const uint64_t bits = key << 48;
+        double e_low;
+        std::memcpy(&e_low, &bits, sizeof(e_low));
+        while (itable < number_of_tables - 1 && e_low >= e_bounds[itable + 1])
+            itable++;
+        table_idx_map[key - table_key_min] = itable;
+    }
+}
+
+
 int EOS_base::get_table_idx(double e) const {
     //double local_ed = e*hbarc;  // [GeV/fm^3]
     double local_ed = e;  // [1/fm^4]
-    for (int itable = 1; itable < number_of_tables; itable++) {
-        if (local_ed < e_bounds[itable]) {
-            return(itable - 1);
+    if (table_idx_map.empty()) {
+        for (int itable = 1; itable < number_of_tables; itable++) {
+            if (local_ed < e_bounds[itable]) {
+                return(itable - 1);
+            }
         }
+        return(std::max(0, number_of_tables - 1));
     }
-    return(std::max(0, number_of_tables - 1));
+    if (local_ed < e_bounds[1]) return(0);
+    // e above the last bound or nan
+    const uint64_t key = get_table_key(local_ed) - table_key_min;
+    if (key >= table_idx_map.size()) return(number_of_tables - 1);
+    int itable = table_idx_map[key];
+    while (itable < number_of_tables - 1 && local_ed >= e_bounds[itable + 1])
+        itable++;
+    return(itable);
 }
 
 
@@ -354,6 +594,282 @@ std::string EOS_base::get_hydro_env_path() const {
 }
 
 
+namespace {
+
+//! the fixed-size header of the binary EoS cache
+struct TableCacheHeader {
+    char magic[8];
+    int32_t version;
+    int32_t eos_id;
+    int32_t n_tables;
+    int32_t n_quantities;
+    int32_t n_interleaved;
+    uint32_t byte_order;
+    uint64_t source_stamp;
+    uint64_t file_size;
+    char padding[16];
+};
+static_assert(sizeof(TableCacheHeader) == 64,
+              "the EoS cache header has to be one cache line");
+
+//! per sub-table grid information of the binary EoS cache
+struct TableCacheInfo {
+    double nb_bounds;
+    double e_bounds;
+    double nb_spacing;
+    double e_spacing;
+    int32_t nb_length;
+    int32_t e_length;
+};
+
+const char table_cache_magic[8] = {'M', 'U', 'S', 'I', 'C', 'E', 'O', 'S'};
+const uint32_t table_cache_byte_order = 0x01020304;
+
+uint64_t align_to_cache_line(const uint64_t offset) {
+    return((offset + 63) & ~static_cast<uint64_t>(63));
+}
+
+//! the size of a cache with the given sub-table sizes in bytes
+uint64_t get_table_cache_size(const std::vector<int> &nb_length,
+                              const std::vector<int> &e_length,
+                              const int n_quantities,
+                              const int n_interleaved) {
+    const int n_tables = static_cast<int>(nb_length.size());
+    uint64_t n_nodes = 0;
+    uint64_t size = sizeof(TableCacheHeader);
+    size += n_tables*sizeof(TableCacheInfo);
+    for (int q = 0; q < n_quantities; q++) {
+        for (int itable = 0; itable < n_tables; itable++) {
+            size = align_to_cache_line(size);
+            size += (static_cast<uint64_t>(nb_length[itable])
+                     *e_length[itable]*sizeof(double));
+        }
+    }
+    for (int itable = 0; itable < n_tables; itable++)
+        n_nodes += static_cast<uint64_t>(nb_length[itable])*e_length[itable];
+    if (n_interleaved > 0) {
+        size = align_to_cache_line(size);
+        size += n_nodes*n_interleaved*sizeof(double);
+    }
+    return(size);
+}
+
+}  // namespace
+
+
+//! This function returns the name of the binary cache of the tables in the
+//! directory path, the layout version is part of the name
+std::string EOS_base::get_table_cache_name(const std::string &path) const {
+    return(path + "music_eos_cache_v" + std::to_string(table_cache_version)
+           + ".bin");
+}
+
+
+//! This function combines the sizes and modification times of the table
+//! files, it returns 0 if one of them does not exist
+uint64_t EOS_base::get_source_stamp(const std::vector<std::string> &files) {
+    uint64_t stamp = 14695981039346656037ULL;
+    for (const auto &file : files) {
+        struct stat file_stat;
+        if (stat(file.c_str(), &file_stat) != 0) return(0);
+        for (const uint64_t value : {
+                static_cast<uint64_t>(file_stat.st_size),
+                static_cast<uint64_t>(file_stat.st_mtime)}) {
+            stamp ^= value;
+            stamp *= 1099511628211ULL;
+        }
+    }
+    return(stamp);
+}
+
+
+//! This function maps the tables from the binary cache written by
+//! write_table_cache(). The cache is read-only and shared by all processes
+//! on a node. It returns false if the cache does not exist, has another
+//! layout or number of tables than n_tables, or is older than the table
+//! files (source_stamp, 0 if the table files are not available). The size
+//! of the file has to match the layout of its sub-tables, so that no table
+//! points past the mapping. tables are the pointers to the table members
+//! in the order given to write_table_cache().
+bool EOS_base::load_table_cache(const std::string &filename,
+                                const uint64_t source_stamp,
+                                const int n_tables,
+                                const std::vector<double****> &tables) {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return(false);
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0
+        || file_stat.st_size < static_cast<off_t>(sizeof(TableCacheHeader))) {
+        close(fd);
+        return(false);
+    }
+    const size_t size = static_cast<size_t>(file_stat.st_size);
+    void *map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return(false);
+
+    const char *base = static_cast<const char*>(map);
+    TableCacheHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    const int n_quantities = static_cast<int>(tables.size());
+    bool valid = (std::memcmp(header.magic, table_cache_magic, 8) == 0
+                  && header.version == table_cache_version
+                  && header.byte_order == table_cache_byte_order
+                  && header.eos_id == whichEOS
+                  && header.n_tables == n_tables
+                  && header.n_quantities == n_quantities
+                  && (header.n_interleaved == 0
+                      || header.n_interleaved == n_quantities)
+                  && header.file_size == size
+                  && (sizeof(TableCacheHeader)
+                      + n_tables*sizeof(TableCacheInfo) <= size));
+    std::vector<TableCacheInfo> infos(valid ? n_tables : 0);
+    std::vector<int> nb_length_cache(infos.size()), e_length_cache(infos.size());
+    for (unsigned int itable = 0; itable < infos.size(); itable++) {
+        std::memcpy(&infos[itable], base + sizeof(TableCacheHeader)
+                                    + itable*sizeof(TableCacheInfo),
+                    sizeof(TableCacheInfo));
+        nb_length_cache[itable] = infos[itable].nb_length;
+        e_length_cache[itable]  = infos[itable].e_length;
+        // at least the two nodes of the interpolation, at most 2^20
+        valid = (valid && infos[itable].nb_length >= 2
+                 && infos[itable].e_length >= 2
+                 && infos[itable].nb_length <= (1 << 20)
+                 && infos[itable].e_length <= (1 << 20));
+    }
+    valid = (valid && get_table_cache_size(nb_length_cache, e_length_cache,
+                                           n_quantities,
+                                           header.n_interleaved) == size);
+    if (!valid || (source_stamp != 0
+                   && header.source_stamp != source_stamp)) {
+        munmap(map, size);
+        music_message.info("The EoS cache " + filename
+                           + " is outdated, reading the tables.");
+        return(false);
+    }
+
+    set_number_of_tables(n_tables);
+    resize_table_info_arrays();
+    for (int itable = 0; itable < number_of_tables; itable++) {
+        nb_bounds[itable]  = infos[itable].nb_bounds;
+        e_bounds[itable]   = infos[itable].e_bounds;
+        nb_spacing[itable] = infos[itable].nb_spacing;
+        e_spacing[itable]  = infos[itable].e_spacing;
+        nb_length[itable]  = infos[itable].nb_length;
+        e_length[itable]   = infos[itable].e_length;
+    }
+    uint64_t offset = (sizeof(TableCacheHeader)
+                       + number_of_tables*sizeof(TableCacheInfo));
+    mapped_tables = map;
+    mapped_size   = size;
+    double *values = const_cast<double*>(reinterpret_cast<const double*>(base));
+    for (int q = 0; q < n_quantities; q++) {
+        *tables[q] = new double** [number_of_tables];
+        for (int itable = 0; itable < number_of_tables; itable++) {
+            offset = align_to_cache_line(offset);
+            double *block = values + offset/sizeof(double);
+            double **table = new double* [nb_length[itable]];
+            for (int i = 0; i < nb_length[itable]; i++)
+                table[i] = block + i*e_length[itable];
+            (*tables[q])[itable] = table;
+            offset += (static_cast<uint64_t>(nb_length[itable])
+                       *e_length[itable]*sizeof(double));
+        }
+    }
+    if (header.n_interleaved > 0) {
+        set_interleaved_offsets(header.n_interleaved);
+        offset = align_to_cache_line(offset);
+        interleaved_tb = values + offset/sizeof(double);
+    }
+    return(true);
+}
+
+
+//! This function writes the tables (and the interleaved table, if it is
+//! built) in their in-memory layout to a binary cache for
+//! load_table_cache(). The file is written under a temporary name and
+//! renamed, so that concurrent jobs never see a partial cache. A failure
+//! only leaves the cache out.
+void EOS_base::write_table_cache(const std::string &filename,
+                                 const uint64_t source_stamp,
+                                 const std::vector<double***> &tables) {
+    const std::string tmp_filename = (filename + ".tmp"
+                                      + std::to_string(getpid()));
+    std::ofstream cache(tmp_filename, std::ios::binary);
+    if (!cache.is_open()) {
+        music_message.warning("Can not write the EoS cache " + filename);
+        return;
+    }
+    const int n_quantities = static_cast<int>(tables.size());
+    TableCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, table_cache_magic, 8);
+    header.version       = table_cache_version;
+    header.eos_id        = whichEOS;
+    header.n_tables      = number_of_tables;
+    header.n_quantities  = n_quantities;
+    header.n_interleaved = (interleaved_tb != nullptr ? n_interleaved : 0);
+    header.byte_order    = table_cache_byte_order;
+    header.source_stamp  = source_stamp;
+
+    const uint64_t size = get_table_cache_size(nb_length, e_length,
+                                               n_quantities,
+                                               header.n_interleaved);
+    long n_interleaved_values = 0;
+    if (header.n_interleaved > 0) {
+        n_interleaved_values = (interleaved_offset[number_of_tables - 1]
+                                + static_cast<long>(
+                                    nb_length[number_of_tables - 1])
+                                  *e_length[number_of_tables - 1]
+                                  *n_interleaved);
+    }
+    header.file_size = size;
+
+    uint64_t offset = 0;
+    auto write_block = [&](const void *data, const uint64_t n_bytes) {
+        cache.write(static_cast<const char*>(data), n_bytes);
+        offset += n_bytes;
+    };
+    auto pad_to_cache_line = [&]() {
+        const char zeros[64] = {0};
+        write_block(zeros, align_to_cache_line(offset) - offset);
+    };
+    write_block(&header, sizeof(header));
+    for (int itable = 0; itable < number_of_tables; itable++) {
+        TableCacheInfo info;
+        std::memset(&info, 0, sizeof(info));
+        info.nb_bounds  = nb_bounds[itable];
+        info.e_bounds   = e_bounds[itable];
+        info.nb_spacing = nb_spacing[itable];
+        info.e_spacing  = e_spacing[itable];
+        info.nb_length  = nb_length[itable];
+        info.e_length   = e_length[itable];
+        write_block(&info, sizeof(info));
+    }
+    for (int q = 0; q < n_quantities; q++) {
+        for (int itable = 0; itable < number_of_tables; itable++) {
+            pad_to_cache_line();
+            // the rows of a table are contiguous (Util::mtx_malloc)
+            write_block(tables[q][itable][0],
+                        static_cast<uint64_t>(nb_length[itable])
+                        *e_length[itable]*sizeof(double));
+        }
+    }
+    if (header.n_interleaved > 0) {
+        pad_to_cache_line();
+        write_block(interleaved_tb, n_interleaved_values*sizeof(double));
+    }
+    cache.close();
+    if (!cache || offset != size
+        || std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        std::remove(tmp_filename.c_str());
+        music_message.warning("Can not write the EoS cache " + filename);
+        return;
+    }
+    music_message.info("Wrote the EoS cache " + filename);
+}
+
+
 void EOS_base::resize_table_info_arrays() {
     nb_bounds.resize(number_of_tables, 0.0);
     nb_spacing.resize(number_of_tables, 0.0);
@@ -595,3 +1111,74 @@ void EOS_base::outputMutable() const {
     }
     check_file9.close();
 }
+
+
+//! This function times the EoS queries at n_queries random (e, rhob) points,
+//! e is log-uniform between 1e-3 GeV/fm^3 and eps_max, rhob is uniform
+//! within the first table. The sums are printed as a check of the results.
+void EOS_base::benchmark_eos(const int n_queries) const {
+    std::mt19937 rng(1);
+    const double log_e_min = log(1e-3/hbarc);
+    const double log_e_max = log(eps_max);
+    double rhob_max = 0.;
+    if (flag_muB && number_of_tables > 0)
+        rhob_max = nb_bounds[0] + nb_spacing[0]*(nb_length[0] - 1);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    std::vector<double> e_list(n_queries);
+    std::vector<double> rhob_list(n_queries);
+    for (int i = 0; i < n_queries; i++) {
+        e_list[i] = exp(log_e_min + (log_e_max - log_e_min)*uniform(rng));
+        rhob_list[i] = rhob_max*uniform(rng);
+    }
+
+    auto time_query = [&](const std::string &name,
+                          std::function<double(double, double)> query) {
+        const auto start = std::chrono::steady_clock::now();
+        double sum = 0.;
+        for (int i = 0; i < n_queries; i++)
+            sum += query(e_list[i], rhob_list[i]);
+        const std::chrono::duration<double, std::nano> elapsed = (
+                                    std::chrono::steady_clock::now() - start);
+        cout << "benchmark_eos: " << setw(18) << name << setw(10)
+             << setprecision(4) << elapsed.count()/n_queries
+             << " ns/query,  sum = " << setprecision(17) << sum << endl;
+    };
+    cout << "benchmark_eos: EOS " << whichEOS << ", " << number_of_tables
+         << " tables, " << n_queries << " random queries" << endl;
+    time_query("get_table_idx", [this](double e, double rhob) {
+                   return(get_table_idx(e));});
+    time_query("get_pressure", [this](double e, double rhob) {
+                   return(get_pressure(e, rhob));});
+    time_query("get_temperature", [this](double e, double rhob) {
+                   return(get_temperature(e, rhob));});
+    time_query("get_muB", [this](double e, double rhob) {
+                   return(get_muB(e, rhob));});
+    time_query("get_cs2", [this](double e, double rhob) {
+                   return(get_cs2(e, rhob));});
+    time_query("5 single calls", [this](double e, double rhob) {
+                   return(get_pressure(e, rhob) + get_temperature(e, rhob)
+                          + get_muB(e, rhob) + get_cs2(e, rhob)
+                          + get_entropy(e, rhob));});
+    time_query("get_thermo", [this](double e, double rhob) {
+                   const EOSThermo thermo = get_thermo(e, rhob, true);
+                   return(thermo.pressure + thermo.T + thermo.muB
+                          + thermo.cs2 + thermo.entropy);});
+    time_query("get_thermo, no cs2", [this](double e, double rhob) {
+                   const EOSThermo thermo = get_thermo(e, rhob, false);
+                   return(thermo.pressure + thermo.T + thermo.muB
+                          + thermo.entropy);});
+
+    std::vector<double> p_list(n_queries);
+    const auto start = std::chrono::steady_clock::now();
+    get_pressure_batch(n_queries, e_list.data(), rhob_list.data(),
+                       p_list.data());
+    const std::chrono::duration<double, std::nano> elapsed = (
+                                std::chrono::steady_clock::now() - start);
+    double sum = 0.;
+    for (int i = 0; i < n_queries; i++)
+        sum += p_list[i];
+    cout << "benchmark_eos: " << setw(18) << "get_pressure_batch"
+         << setw(10) << setprecision(4) << elapsed.count()/n_queries
+         << " ns/query,  sum = " << setprecision(17) << sum << endl;
+    cout << setprecision(6);
+}
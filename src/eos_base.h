@@ -5,9 +5,23 @@
 
 #include "pretty_ostream.h"
 
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 
+//! thermodynamic quantities at one (e, rhob), see EOS_base::get_thermo()
+struct EOSThermo {
+    double pressure = 0;   //!< [1/fm^4]
+    double T = 0;          //!< [1/fm]
+    double muB = 0;        //!< [1/fm]
+    double muS = 0;        //!< [1/fm]
+    double muC = 0;        //!< [1/fm]
+    double cs2 = 0;
+    double entropy = 0;    //!< [1/fm^3]
+};
+
+
 class EOS_base {
  private:
     int whichEOS;
@@ -17,6 +31,62 @@ class EOS_base {
     bool flag_muS;
     bool flag_muC;
 
+    //! table id for every value of the leading 16 bits of e (sign,
+    //! exponent and the first 4 mantissa bits, 1/16 of an octave) between
+    //! e_bounds[1] and the last table bound, see build_table_idx_map()
+    std::vector<int> table_idx_map;
+    uint64_t table_key_min = 0;
+
+    static uint64_t get_table_key(double e) {
+        uint64_t bits;
+        std::memcpy(&bits, &e, sizeof(bits));
+        return(bits >> 48);
+    }
+
+ protected:
+    //! indices and weights of the bilinear interpolation at one (e, rhob),
+    //! shared by all tables of the same EoS
+    struct Stencil2D {
+        int table_idx;
+        int idx_e;
+        int idx_nb;
+        double frac_e;
+        double frac_rhob;
+    };
+    Stencil2D get_stencil2D(const double e, const double rhob,
+                            const int table_idx) const;
+    double interpolate2D(const Stencil2D &stencil, double ***table) const;
+
+    //! the tables of several quantities with the values of a node next to
+    //! each other, so that one cache line serves all of them; the node
+    //! (table, idx_nb, idx_e) starts at interleaved_offset[table]
+    //! + (idx_nb*e_length[table] + idx_e)*n_interleaved
+    double *interleaved_tb = nullptr;
+    int n_interleaved = 0;
+    std::vector<long> interleaved_offset;
+    long set_interleaved_offsets(const int n_quantities);
+    void build_interleaved_table(const std::vector<double***> &tables);
+    void interpolate2D_interleaved(const Stencil2D &stencil,
+                                   double *values) const;
+
+    double get_entropy(const double epsilon, const double rhob,
+                       const EOSThermo &thermo) const;
+
+    //! binary cache of the tables in their in-memory layout; the tables
+    //! loaded from it point into a read-only shared mapping of the file
+    static const int table_cache_version = 1;
+    void *mapped_tables = nullptr;
+    size_t mapped_size = 0;
+    std::string get_table_cache_name(const std::string &path) const;
+    static uint64_t get_source_stamp(const std::vector<std::string> &files);
+    bool load_table_cache(const std::string &filename,
+                          const uint64_t source_stamp, const int n_tables,
+                          const std::vector<double****> &tables);
+    void write_table_cache(const std::string &filename,
+                           const uint64_t source_stamp,
+                           const std::vector<double***> &tables);
+    void free_table(double **table, const int itable);
+
  public:
     pretty_ostream music_message;
     std::vector<double> nb_bounds;
@@ -61,11 +131,17 @@ class EOS_base {
     double interpolate1D(double e, int table_idx, double ***table) const;
     double interpolate2D(const double e, const double rhob,
                          const int table_idx, double ***table) const;
+    void   interpolate2D_batch(const int n, const double *e,
+                               const double *rhob, double ***table,
+                               double *results) const;
 
+    void   build_table_idx_map();
     int    get_table_idx(double e) const;
     double get_entropy  (double epsilon, double rhob) const;
 
     double calculate_velocity_of_sound_sq(double e, double rhob) const;
+    double calculate_velocity_of_sound_sq(double e, double rhob,
+                                          double pressure) const;
     double get_dpOverde3(double e, double rhob) const;
     double get_dpOverdrhob2(double e, double rhob) const;
     double get_s2e_finite_rhob(double s, double rhob) const;
@@ -85,13 +161,22 @@ class EOS_base {
     virtual double get_rhoS       (double epsilon, double rhob) const {return(0.0);}
     virtual double get_rhoC       (double epsilon, double rhob) const {return(0.4*rhob);}
     virtual double get_pressure   (double epsilon, double rhob) const {return(0.0);}
+    virtual void   get_pressure_batch(const int n, const double *epsilon,
+                                      const double *rhob, double *p) const;
     virtual double get_s2e        (double s, double rhob) const {return(0.0);}
     virtual double get_T2e        (double T_in_GeV, double rhob) const {return(0.0);}
     virtual void   check_eos      () const {}
 
+    // returns all quantities of EOSThermo at once (cs2 only with_cs2, it
+    // needs four more pressure lookups); derived classes with a faster
+    // joint lookup override it, the default calls the functions above (and
+    // get_cs2, so it respects its overrides)
+    virtual EOSThermo get_thermo  (double e, double rhob, bool with_cs2) const;
+
     void check_eos_with_finite_muB() const;
     void check_eos_no_muB() const;
     void outputMutable() const;
+    void benchmark_eos(const int n_queries) const;
 };
 
 
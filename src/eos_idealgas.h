@@ -6,7 +6,9 @@
 #include "eos_base.h"
 #include "util.h"
 
-class EOS_idealgas : public EOS_base {
+#include <cmath>
+
+class EOS_idealgas final : public EOS_base {
  private:
      double Nc;
      double Nf;
@@ -21,13 +23,31 @@ class EOS_idealgas : public EOS_base {
     double get_cs2        (double e, double rhob) const {return(1./3.);}
     double p_rho_func     (double e, double rhob) const {return(0.0);}
     double p_e_func       (double e, double rhob) const {return(1./3.);}
-    double get_temperature(double e, double rhob) const;
-    double get_muB        (double e, double rhob) const;
+    double get_temperature(double e, double rhob) const {
+        return(pow(90.0/M_PI/M_PI*(e/3.0)/(2*(Nc*Nc-1)+7./2*Nc*Nf), .25));
+    }
+    double get_muB        (double e, double rhob) const {
+        double T_local = get_temperature(e, rhob);
+        double mu_B = 5.*rhob/(T_local*T_local);  // [1/fm]
+        return(mu_B);
+    }
     double get_muS        (double e, double rhob) const {return(0.0);}
     double get_pressure   (double e, double rhob) const {return(1./3.*e);}
     double get_s2e        (double s, double rhob) const;
     double get_T2e        (double T_in_GeV, double rhob) const;
 
+    //! all thermodynamic quantities of EOSThermo, T is computed once for T
+    //! and mu_B
+    EOSThermo get_thermo  (double e, double rhob, bool with_cs2) const {
+        EOSThermo thermo;
+        thermo.pressure = get_pressure(e, rhob);
+        thermo.T        = get_temperature(e, rhob);
+        thermo.muB      = 5.*rhob/(thermo.T*thermo.T);  // [1/fm]
+        if (with_cs2) thermo.cs2 = get_cs2(e, rhob);
+        thermo.entropy  = get_entropy(e, rhob, thermo);
+        return(thermo);
+    }
+
     void check_eos() const {check_eos_no_muB();}
 };
 
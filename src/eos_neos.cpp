@@ -23,15 +23,12 @@ EOS_neos::EOS_neos(const int eos_id_in) : eos_id(eos_id_in) {
 EOS_neos::~EOS_neos() {
     int ntables = get_number_of_tables();
     for (int itable = 0; itable < ntables; itable++) {
-        Util::mtx_free(mu_B_tb[itable],
-                       nb_length[itable], e_length[itable]);
+        free_table(mu_B_tb[itable], itable);
         if (get_flag_muS()) {
-            Util::mtx_free(mu_S_tb[itable],
-                           nb_length[itable], e_length[itable]);
+            free_table(mu_S_tb[itable], itable);
         }
         if (get_flag_muC()) {
-            Util::mtx_free(mu_C_tb[itable],
-                           nb_length[itable], e_length[itable]);
+            free_table(mu_C_tb[itable], itable);
         }
     }
     if (ntables > 0) {
@@ -110,6 +107,30 @@ void EOS_neos::initialize_eos() {
     music_message.flush("info");
 
     const int ntables = 7;
+
+    // use the binary cache of the tables if it is up to date
+    std::vector<string> table_files;
+    for (int itable = 0; itable < ntables; itable++) {
+        const string prefix = path + "neos" + eos_file_string_array[itable];
+        table_files.push_back(prefix + "_p.dat");
+        table_files.push_back(prefix + "_t.dat");
+        table_files.push_back(prefix + "_mub.dat");
+        if (flag_muS) table_files.push_back(prefix + "_mus.dat");
+        if (flag_muC) table_files.push_back(prefix + "_muq.dat");
+    }
+    const string cache_file = get_table_cache_name(path);
+    const uint64_t source_stamp = get_source_stamp(table_files);
+    std::vector<double****> table_ptrs = {&pressure_tb, &temperature_tb,
+                                          &mu_B_tb};
+    if (flag_muS) table_ptrs.push_back(&mu_S_tb);
+    if (flag_muC) table_ptrs.push_back(&mu_C_tb);
+    if (load_table_cache(cache_file, source_stamp, ntables, table_ptrs)) {
+        set_eps_max(e_bounds[6] + e_spacing[6]*e_length[6]);
+        build_table_idx_map();
+        music_message.info("Done reading EOS from " + cache_file);
+        return;
+    }
+
     set_number_of_tables(ntables);
     resize_table_info_arrays();
 
@@ -234,6 +255,15 @@ void EOS_neos::initialize_eos() {
     //double eps_max_in = (e_bounds[6] + e_spacing[6]*e_length[6])/hbarc;
     double eps_max_in = e_bounds[6] + e_spacing[6]*e_length[6];
     set_eps_max(eps_max_in);
+    build_table_idx_map();
+
+    // node-interleaved copy of the tables for get_thermo
+    std::vector<double***> thermo_tables = {pressure_tb, temperature_tb,
+                                            mu_B_tb};
+    if (flag_muS) thermo_tables.push_back(mu_S_tb);
+    if (flag_muC) thermo_tables.push_back(mu_C_tb);
+    build_interleaved_table(thermo_tables);
+    write_table_cache(cache_file, source_stamp, thermo_tables);
 
     music_message.info("Done reading EOS.");
 }
@@ -306,6 +336,45 @@ double EOS_neos::get_muC(double e, double rhob) const {
 }
 
 
+//! This function returns the local pressure in [1/fm^4] at n points
+//! the input local energy density [1/fm^4], rhob [1/fm^3]
+void EOS_neos::get_pressure_batch(const int n, const double *epsilon,
+                                  const double *rhob, double *p) const {
+    std::vector<double> rhob_abs(n);
+    for (int i = 0; i < n; i++)
+        rhob_abs[i] = std::abs(rhob[i]);
+    interpolate2D_batch(n, epsilon, rhob_abs.data(), pressure_tb, p);
+    for (int i = 0; i < n; i++)
+        p[i] = std::max(Util::small_eps, p[i]);
+}
+
+
+//! This function returns all thermodynamic quantities of EOSThermo, the
+//! table and the interpolation weights are looked up once, and all tables
+//! are read from the node-interleaved copy
+EOSThermo EOS_neos::get_thermo(double e, double rhob,
+                               bool with_cs2) const {
+    const Stencil2D stencil = get_stencil2D(e, std::abs(rhob),
+                                            get_table_idx(e));
+    const double sign = rhob/(std::abs(rhob) + Util::small_eps);
+    // pressure, T^5, muB [, muS] [, muC]
+    double values[5];
+    interpolate2D_interleaved(stencil, values);
+    EOSThermo thermo;
+    thermo.pressure = std::max(Util::small_eps, values[0]);
+    const double T5 = std::max(Util::small_eps, values[1]);
+    thermo.T   = pow(T5, 0.2);
+    thermo.muB = sign*values[2];
+    int iq = 3;
+    if (get_flag_muS()) thermo.muS = sign*values[iq++];
+    if (get_flag_muC()) thermo.muC = sign*values[iq++];
+    if (with_cs2)
+        thermo.cs2 = calculate_velocity_of_sound_sq(e, rhob, thermo.pressure);
+    thermo.entropy = get_entropy(e, rhob, thermo);
+    return(thermo);
+}
+
+
 double EOS_neos::get_s2e(double s, double rhob) const {
     double e = get_s2e_finite_rhob(s, rhob);
     return(e);
@@ -5,7 +5,7 @@
 
 #include "eos_base.h"
 
-class EOS_neos : public EOS_base {
+class EOS_neos final : public EOS_base {
  private:
     const int eos_id;
 
@@ -22,6 +22,9 @@ class EOS_neos : public EOS_base {
     double get_muC        (double e, double rhob) const;
     double get_pressure   (double e, double rhob) const;
     double get_s2e        (double s, double rhob) const;
+    void get_pressure_batch(const int n, const double *epsilon,
+                            const double *rhob, double *p) const;
+    EOSThermo get_thermo  (double e, double rhob, bool with_cs2) const;
 
     void check_eos() const {
         check_eos_with_finite_muB();
@@ -118,6 +118,7 @@ void EOS_s95p::initialize_eos() {
     //double eps_max_in = (e_bounds[6] + e_spacing[6]*e_length[6])/hbarc;
     double eps_max_in = e_bounds[6] + e_spacing[6]*e_length[6];
     set_eps_max(eps_max_in);
+    build_table_idx_map();
 
     music_message.info("Done reading EOS.");
 }
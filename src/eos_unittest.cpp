@@ -1,16 +1,386 @@
 // Copyright 2018 @ Chun Shen
 
 #include "eos.h"
+#include "util.h"
 #include "doctest.h"
 
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
 
 TEST_CASE("test constructor") {
     EOS test(0);
     CHECK(test.get_pressure(1.0, 0.0) == 1./3.);
     CHECK(test.get_dpde(1.0, 0.0)     == 1./3.);
     CHECK(test.get_dpdrhob(1.0, 0.0)  == 0.0);
-    CHECK(test.get_muB(1.0, 1.0)      == 0.0);
+    CHECK(test.get_muB(1.0, 0.0)      == 0.0);
+    const double T = test.get_temperature(1.0, 1.0);
+    CHECK(test.get_muB(1.0, 1.0)      == 5./(T*T));
     CHECK(test.get_muS(1.0, -1.0)     == 0.0);
 }
+
+
+//! a table EoS with the given bounds in e, every table has n_e x n_rhob
+//! nodes with P = e/3 + rhob^2 and T^5 = e + rhob
+class EOS_test_table : public EOS_base {
+ public:
+    using EOS_base::Stencil2D;
+    using EOS_base::get_stencil2D;
+    using EOS_base::interpolate2D;
+    using EOS_base::build_interleaved_table;
+    using EOS_base::interpolate2D_interleaved;
+    using EOS_base::load_table_cache;
+    using EOS_base::write_table_cache;
+
+    //! an EoS without tables, e.g. to load a cache
+    EOS_test_table() {
+        set_EOS_id(99);
+        set_number_of_tables(0);
+    }
+
+    EOS_test_table(const std::vector<double> &bounds, const int n_e,
+                   const int n_rhob) {
+        const int ntables = static_cast<int>(bounds.size());
+        set_EOS_id(99);
+        set_number_of_tables(ntables);
+        resize_table_info_arrays();
+        pressure_tb    = new double** [ntables];
+        temperature_tb = new double** [ntables];
+        for (int itable = 0; itable < ntables; itable++) {
+            e_bounds[itable]   = bounds[itable];
+            nb_bounds[itable]  = 0.;
+            e_length[itable]   = n_e;
+            nb_length[itable]  = n_rhob;
+            nb_spacing[itable] = 0.1;
+            if (itable + 1 < ntables) {
+                e_spacing[itable] = ((bounds[itable + 1] - bounds[itable])
+                                     /n_e);
+            } else {
+                e_spacing[itable] = 2.*bounds[itable]/n_e;
+            }
+            pressure_tb[itable]    = Util::mtx_malloc(n_rhob, n_e);
+            temperature_tb[itable] = Util::mtx_malloc(n_rhob, n_e);
+            for (int i = 0; i < n_rhob; i++) {
+                for (int j = 0; j < n_e; j++) {
+                    const double e = bounds[itable] + j*e_spacing[itable];
+                    const double rhob = i*nb_spacing[itable];
+                    pressure_tb[itable][i][j]    = e/3. + rhob*rhob;
+                    temperature_tb[itable][i][j] = e + rhob;
+                }
+            }
+        }
+        set_flag_muB(true);
+        set_eps_max(2.*bounds[ntables - 1]);
+        build_table_idx_map();
+    }
+};
+
+
+TEST_CASE("test table index map") {
+    const std::vector<double> bounds = {0., 3.6e-4, 1.8e-3, 1.8e-3*1.01,
+                                        0.1, 2.5, 90.};
+    EOS_test_table test(bounds, 2, 2);
+    CHECK(test.get_table_idx(-1.0) == 0);
+    CHECK(test.get_table_idx(0.0)  == 0);
+    CHECK(test.get_table_idx(1e5)  == 6);
+    for (int itable = 1; itable < 7; itable++) {
+        CHECK(test.get_table_idx(bounds[itable]) == itable);
+        CHECK(test.get_table_idx(std::nextafter(bounds[itable], 0.))
+              == itable - 1);
+    }
+    for (double e = 1e-5; e < 200.; e *= 1.001) {
+        int itable = 6;
+        while (itable > 0 && e < bounds[itable]) itable--;
+        CHECK(test.get_table_idx(e) == itable);
+    }
+}
+
+
+TEST_CASE("test get_thermo") {
+    EOS test(0);
+    const double e = 2.5;
+    const double rhob = 0.3;
+    const EOSThermo thermo = test.get_thermo(e, rhob);
+    CHECK(thermo.pressure == test.get_pressure(e, rhob));
+    CHECK(thermo.T        == test.get_temperature(e, rhob));
+    CHECK(thermo.muB      == test.get_muB(e, rhob));
+    CHECK(thermo.muS      == test.get_muS(e, rhob));
+    CHECK(thermo.muC      == test.get_muC(e, rhob));
+    CHECK(thermo.cs2      == test.get_cs2(e, rhob));
+    CHECK(thermo.entropy  == test.get_entropy(e, rhob));
+    CHECK(test.get_thermo(e, rhob, false).cs2 == 0.);
+}
+
+
+TEST_CASE("test get_pressure_batch") {
+    EOS test(0);
+    const int n = 100;
+    std::vector<double> e(n), rhob(n), p(n);
+    for (int i = 0; i < n; i++) {
+        e[i] = 0.01*(i + 1);
+        rhob[i] = 0.001*i;
+    }
+    test.get_pressure_batch(n, e.data(), rhob.data(), p.data());
+    for (int i = 0; i < n; i++)
+        CHECK(p[i] == test.get_pressure(e[i], rhob[i]));
+}
+
+
+//! the directory of the repository, which holds the EoS tables in EOS/;
+//! "." if the source path is relative
+std::string get_repository_path() {
+    const std::string file = __FILE__;
+    const auto pos = file.rfind("src/eos_unittest.cpp");
+    if (pos == std::string::npos || pos == 0) return(".");
+    return(file.substr(0, pos - 1));
+}
+
+
+//! a scratch HYDROPROGRAMPATH with links to the tables of the repository
+//! in EOS/<eos_dir>, so that the EoS cache is written (and removed) there
+//! and not next to the tables of the source tree, which other runs may
+//! have mapped. Everything is removed again on destruction.
+class ScratchEOSPath {
+ private:
+    std::string root_;
+    std::string dir_;
+
+ public:
+    explicit ScratchEOSPath(const std::string &eos_dir) {
+        char root[] = "/tmp/music_eos_unittest_XXXXXX";
+        REQUIRE(mkdtemp(root) != nullptr);
+        root_ = root;
+        dir_  = root_ + "/EOS/" + eos_dir + "/";
+        mkdir((root_ + "/EOS").c_str(), 0700);
+        mkdir(dir_.c_str(), 0700);
+        const std::string source = (
+                    get_repository_path() + "/EOS/" + eos_dir + "/");
+        DIR *dir = opendir(source.c_str());
+        REQUIRE(dir != nullptr);
+        while (const dirent *entry = readdir(dir)) {
+            const std::string name = entry->d_name;
+            if (name.size() < 4 || name.substr(name.size() - 4) != ".dat") {
+                continue;
+            }
+            REQUIRE(symlink((source + name).c_str(),
+                            (dir_ + name).c_str()) == 0);
+        }
+        closedir(dir);
+        setenv("HYDROPROGRAMPATH", root_.c_str(), 1);
+    }
+
+    ~ScratchEOSPath() {
+        if (DIR *dir = opendir(dir_.c_str())) {
+            while (const dirent *entry = readdir(dir)) {
+                const std::string name = entry->d_name;
+                if (name != "." && name != "..") {
+                    unlink((dir_ + name).c_str());
+                }
+            }
+            closedir(dir);
+        }
+        rmdir(dir_.c_str());
+        rmdir((root_ + "/EOS").c_str());
+        rmdir(root_.c_str());
+    }
+
+    //! the directory holding the table links, with a trailing /
+    const std::string& table_dir() const {return(dir_);}
+};
+
+
+TEST_CASE("test batch and interleaved interpolation") {
+    const std::vector<double> bounds = {0.01, 0.05, 0.2, 1.0};
+    EOS_test_table test(bounds, 12, 5);
+    test.build_interleaved_table({test.pressure_tb, test.temperature_tb});
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    const int n = 1000;
+    std::vector<double> e(n), rhob(n), p(n);
+    for (int i = 0; i < n; i++) {
+        e[i] = 2.5*uniform(rng);
+        rhob[i] = 0.5*uniform(rng);
+    }
+    // the last node of a table, interpolated towards the next table
+    e[0] = bounds[1] - 1e-6;
+    e[1] = bounds[2] - 1e-6;
+    test.interpolate2D_batch(n, e.data(), rhob.data(), test.pressure_tb,
+                             p.data());
+    for (int i = 0; i < n; i++) {
+        const int table_idx = test.get_table_idx(e[i]);
+        const double p_ref = test.interpolate2D(e[i], rhob[i], table_idx,
+                                                test.pressure_tb);
+        const double T5_ref = test.interpolate2D(e[i], rhob[i], table_idx,
+                                                 test.temperature_tb);
+        CHECK(p[i] == p_ref);
+        double values[2];
+        test.interpolate2D_interleaved(
+            test.get_stencil2D(e[i], rhob[i], table_idx), values);
+        CHECK(values[0] == p_ref);
+        CHECK(values[1] == T5_ref);
+    }
+}
+
+
+TEST_CASE("test neos get_thermo and get_pressure_batch") {
+    const std::string path = get_repository_path();
+    if (!std::ifstream(path + "/EOS/neos_bqs/neos1qs_p.dat").is_open()) {
+        MESSAGE("the neos_bqs tables are not available");
+        return;
+    }
+    ScratchEOSPath scratch("neos_bqs");
+    EOS test(14);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    const int n = 1000;
+    std::vector<double> e(n), rhob(n), p(n);
+    for (int i = 0; i < n; i++) {
+        e[i] = exp(log(1e-3) + (log(100.) - log(1e-3))*uniform(rng));
+        rhob[i] = 0.4*(uniform(rng) - 0.5);
+    }
+    test.get_pressure_batch(n, e.data(), rhob.data(), p.data());
+    for (int i = 0; i < n; i++) {
+        CHECK(p[i] == test.get_pressure(e[i], rhob[i]));
+        const EOSThermo thermo = test.get_thermo(e[i], rhob[i]);
+        CHECK(thermo.pressure == test.get_pressure(e[i], rhob[i]));
+        CHECK(thermo.T        == test.get_temperature(e[i], rhob[i]));
+        CHECK(thermo.muB      == test.get_muB(e[i], rhob[i]));
+        CHECK(thermo.muS      == test.get_muS(e[i], rhob[i]));
+        CHECK(thermo.muC      == test.get_muC(e[i], rhob[i]));
+        CHECK(thermo.cs2      == test.get_cs2(e[i], rhob[i]));
+        CHECK(thermo.entropy  == test.get_entropy(e[i], rhob[i]));
+    }
+}
+
+
+//! checks that two EoS have the same tables
+void check_same_tables(const EOS_base &eos1, const EOS_base &eos2,
+                       const std::vector<double***> &tables1,
+                       const std::vector<double***> &tables2) {
+    const int ntables = eos1.get_number_of_tables();
+    REQUIRE(eos2.get_number_of_tables() == ntables);
+    CHECK(eos1.nb_bounds  == eos2.nb_bounds);
+    CHECK(eos1.e_bounds   == eos2.e_bounds);
+    CHECK(eos1.nb_spacing == eos2.nb_spacing);
+    CHECK(eos1.e_spacing  == eos2.e_spacing);
+    REQUIRE(eos1.nb_length == eos2.nb_length);
+    REQUIRE(eos1.e_length  == eos2.e_length);
+    REQUIRE(tables1.size() == tables2.size());
+    int n_diff = 0;
+    for (unsigned int q = 0; q < tables1.size(); q++)
+    for (int itable = 0; itable < ntables; itable++)
+    for (int i = 0; i < eos1.nb_length[itable]; i++)
+    for (int j = 0; j < eos1.e_length[itable]; j++) {
+        if (tables1[q][itable][i][j] != tables2[q][itable][i][j]) n_diff++;
+    }
+    CHECK(n_diff == 0);
+}
+
+
+TEST_CASE("test table cache") {
+    const std::string filename = "eos_cache_unittest.bin";
+    const std::vector<double> bounds = {0.01, 0.05, 0.2, 1.0};
+    EOS_test_table test(bounds, 12, 5);
+    test.build_interleaved_table({test.pressure_tb, test.temperature_tb});
+    test.write_table_cache(filename, 1,
+                           {test.pressure_tb, test.temperature_tb});
+
+    EOS_test_table cached;
+    REQUIRE(cached.load_table_cache(filename, 1, 4, {&cached.pressure_tb,
+                                                     &cached.temperature_tb}));
+    check_same_tables(test, cached, {test.pressure_tb, test.temperature_tb},
+                      {cached.pressure_tb, cached.temperature_tb});
+    cached.build_table_idx_map();
+    for (double e = 0.001; e < 2.; e *= 1.1) {
+        const int table_idx = test.get_table_idx(e);
+        CHECK(cached.get_table_idx(e) == table_idx);
+        double values[2], values_cached[2];
+        test.interpolate2D_interleaved(
+                test.get_stencil2D(e, 0.15, table_idx), values);
+        cached.interpolate2D_interleaved(
+                cached.get_stencil2D(e, 0.15, table_idx), values_cached);
+        CHECK(values[0] == values_cached[0]);
+        CHECK(values[1] == values_cached[1]);
+    }
+
+    // outdated tables, another number of tables or quantities
+    EOS_test_table rejected;
+    CHECK(!rejected.load_table_cache(filename, 2, 4,
+                                     {&rejected.pressure_tb,
+                                      &rejected.temperature_tb}));
+    CHECK(!rejected.load_table_cache(filename, 1, 7,
+                                     {&rejected.pressure_tb,
+                                      &rejected.temperature_tb}));
+    CHECK(!rejected.load_table_cache(filename, 1, 4,
+                                     {&rejected.pressure_tb}));
+
+    // a damaged cache: a table larger than the file, a truncated file
+    std::string content;
+    {
+        std::ifstream in(filename, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(in),
+                       std::istreambuf_iterator<char>());
+    }
+    std::string damaged = content;
+    const int e_length_offset = 64 + 4*8 + 4;  // e_length of table 0
+    const int32_t e_length_large = 1000;
+    damaged.replace(e_length_offset, sizeof(e_length_large),
+                    reinterpret_cast<const char*>(&e_length_large),
+                    sizeof(e_length_large));
+    std::ofstream(filename, std::ios::binary) << damaged;
+    CHECK(!rejected.load_table_cache(filename, 1, 4,
+                                     {&rejected.pressure_tb,
+                                      &rejected.temperature_tb}));
+    std::ofstream(filename, std::ios::binary)
+        << content.substr(0, content.size() - 64);
+    CHECK(!rejected.load_table_cache(filename, 1, 4,
+                                     {&rejected.pressure_tb,
+                                      &rejected.temperature_tb}));
+    CHECK(rejected.get_number_of_tables() == 0);
+    std::remove(filename.c_str());
+}
+
+
+TEST_CASE("test neos table cache") {
+    const std::string path = get_repository_path();
+    if (!std::ifstream(path + "/EOS/neos_bqs/neos1qs_p.dat").is_open()) {
+        MESSAGE("the neos_bqs tables are not available");
+        return;
+    }
+    ScratchEOSPath scratch("neos_bqs");
+    const std::string cache_file = (
+                    scratch.table_dir() + "music_eos_cache_v1.bin");
+    // read from the ASCII tables and written to the cache
+    EOS_neos ascii(14);
+    ascii.initialize_eos();
+    REQUIRE(std::ifstream(cache_file).is_open());
+    // mapped from the cache
+    EOS_neos cached(14);
+    cached.initialize_eos();
+    check_same_tables(ascii, cached,
+                      {ascii.pressure_tb, ascii.temperature_tb,
+                       ascii.mu_B_tb, ascii.mu_S_tb, ascii.mu_C_tb},
+                      {cached.pressure_tb, cached.temperature_tb,
+                       cached.mu_B_tb, cached.mu_S_tb, cached.mu_C_tb});
+    CHECK(ascii.get_eps_max() == cached.get_eps_max());
+    for (double e = 1e-3; e < 100.; e *= 1.05) {
+        const EOSThermo thermo1 = ascii.get_thermo(e, 0.1, true);
+        const EOSThermo thermo2 = cached.get_thermo(e, 0.1, true);
+        CHECK(thermo1.pressure == thermo2.pressure);
+        CHECK(thermo1.T        == thermo2.T);
+        CHECK(thermo1.muC      == thermo2.muC);
+        CHECK(thermo1.cs2      == thermo2.cs2);
+    }
+}
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+#include "eta_domain.h"
+
+template <class Cell>
+EtaDomainT<Cell>::EtaDomainT(const int neta) : neta_(neta) {
+#ifdef MUSIC_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
+    MPI_Comm_size(MPI_COMM_WORLD, &size_);
+    MPI_Type_contiguous(sizeof(Cell), MPI_BYTE, &cell_type_);
+    MPI_Type_commit(&cell_type_);
+#endif
+    if (size_ > 1 && neta < halo*size_) {
+        music_message << "EtaDomain: " << neta << " eta cells can not be "
+                      << "split over " << size_ << " ranks with at least "
+                      << halo << " cells each!";
+        music_message.flush("error");
+        exit(1);
+    }
+    // the first neta % size_ ranks get one row more
+    slab_begin_.resize(size_ + 1);
+    for (int i = 0; i <= size_; i++) {
+        slab_begin_[i] = i*(neta/size_) + std::min(i, neta % size_);
+    }
+}
+
+
+template <class Cell>
+EtaDomainT<Cell>::~EtaDomainT() {
+#ifdef MUSIC_MPI
+    MPI_Type_free(&cell_type_);
+#endif
+}
+
+
+template <class Cell>
+void EtaDomainT<Cell>::distribute(Grid &arena) const {
+    if (size_ == 1) return;
+    arena = arena.eta_rows(rows_begin(), rows_end());
+}
+
+
+template <class Cell>
+void EtaDomainT<Cell>::exchange_halos(Grid &arena) const {
+#ifdef MUSIC_MPI
+    if (size_ == 1) return;
+    const int count = halo*arena.eta_row_size();
+    const bool has_lower = (rank_ > 0);
+    const bool has_upper = (rank_ < size_ - 1);
+    const int lower = has_lower ? rank_ - 1 : MPI_PROC_NULL;
+    const int upper = has_upper ? rank_ + 1 : MPI_PROC_NULL;
+    // nothing is received from MPI_PROC_NULL, but the buffer has to be valid
+    Cell* lower_halo = arena.eta_row(has_lower ? 0 : ieta_begin());
+    Cell* upper_halo = arena.eta_row(has_upper ? ieta_end() : ieta_begin());
+    // the last rows of every slab go into the lower halo of the next
+    // slab, the first rows into the upper halo of the previous one
+    MPI_Sendrecv(arena.eta_row(ieta_end() - halo), count, cell_type_, upper,
+                 0, lower_halo, count, cell_type_, lower, 0,
+                 MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    MPI_Sendrecv(arena.eta_row(ieta_begin()), count, cell_type_, lower, 1,
+                 upper_halo, count, cell_type_, upper, 1,
+                 MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+#endif
+}
+
+
+template <class Cell>
+GridT<Cell>& EtaDomainT<Cell>::whole_grid(Grid &arena, Grid &buffer) const {
+    if (size_ == 1) return(arena);
+#ifdef MUSIC_MPI
+    Cell* whole_rows = nullptr;
+    if (is_root()) {
+        // reallocated when the transverse grid has changed
+        if (   buffer.nX() != arena.nX() || buffer.nY() != arena.nY()
+            || buffer.nEta() != neta_
+            || buffer.ix_input(0) != arena.ix_input(0)
+            || buffer.iy_input(0) != arena.iy_input(0)) {
+            buffer = arena.eta_rows(-rows_begin(), neta_ - rows_begin());
+        }
+        whole_rows = buffer.eta_row(0);
+    }
+    const int row_size = arena.eta_row_size();
+    std::vector<int> counts(size_), displs(size_);
+    for (int i = 0; i < size_; i++) {
+        displs[i] = slab_begin_[i]*row_size;
+        counts[i] = (slab_begin_[i + 1] - slab_begin_[i])*row_size;
+    }
+    MPI_Gatherv(arena.eta_row(ieta_begin()), counts[rank_], cell_type_,
+                whole_rows, counts.data(), displs.data(), cell_type_, 0,
+                MPI_COMM_WORLD);
+    if (is_root()) {
+        buffer.fill_ghost_cells();
+        return(buffer);
+    }
+#endif
+    return(arena);
+}
+
+
+template <class Cell>
+GridBox EtaDomainT<Cell>::active_box(const Grid &arena, const double eps_cut,
+                                     const int margin) const {
+    if (size_ == 1) return(find_active_box(arena, eps_cut, margin));
+    // bounding box of the cells above eps_cut, hi is reduced as -hi; the
+    // empty boxes drop out of the minimum
+    const GridBox box = find_active_box(arena, eps_cut, 0);
+    int bounds[6] = {INT_MAX, INT_MAX, INT_MAX, INT_MAX, INT_MAX, INT_MAX};
+    if (box.size() > 0) {
+        const int offset[3] = {0, 0, rows_begin()};
+        for (int i = 0; i < 3; i++) {
+            bounds[i]     =   box.lo[i] + offset[i];
+            bounds[i + 3] = -(box.hi[i] + offset[i]);
+        }
+    }
+#ifdef MUSIC_MPI
+    MPI_Allreduce(MPI_IN_PLACE, bounds, 6, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+#endif
+    GridBox res;
+    if (bounds[0] == INT_MAX) return(res);
+    const int n[3] = {arena.nX(), arena.nY(), neta_};
+    for (int i = 0; i < 3; i++) {
+        res.lo[i] = std::max(0, bounds[i] - margin);
+        res.hi[i] = std::min(n[i], -bounds[i + 3] + margin);
+    }
+    return(res);
+}
+
+
+template <class Cell>
+GridBox EtaDomainT<Cell>::slab_part(const GridBox &box) const {
+    GridBox res = box;
+    res.lo[2] = std::max(box.lo[2], slab_begin_[rank_]) - rows_begin();
+    res.hi[2] = std::min(box.hi[2], slab_begin_[rank_ + 1]) - rows_begin();
+    return(res);
+}
+
+
+template <class Cell>
+int EtaDomainT<Cell>::max(const int value) const {
+    int result = value;
+#ifdef MUSIC_MPI
+    if (size_ > 1) {
+        MPI_Allreduce(&value, &result, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    }
+#endif
+    return(result);
+}
+
+
+template <class Cell>
+double EtaDomainT<Cell>::max(const double value) const {
+    double result = value;
+#ifdef MUSIC_MPI
+    if (size_ > 1) {
+        MPI_Allreduce(&value, &result, 1, MPI_DOUBLE, MPI_MAX,
+                      MPI_COMM_WORLD);
+    }
+#endif
+    return(result);
+}
+
+
+template <class Cell>
+double EtaDomainT<Cell>::min(const double value) const {
+    double result = value;
+#ifdef MUSIC_MPI
+    if (size_ > 1) {
+        MPI_Allreduce(&value, &result, 1, MPI_DOUBLE, MPI_MIN,
+                      MPI_COMM_WORLD);
+    }
+#endif
+    return(result);
+}
+
+
+template <class Cell>
+void EtaDomainT<Cell>::sum(std::vector<double> &values) const {
+#ifdef MUSIC_MPI
+    if (size_ > 1 && !values.empty()) {
+        MPI_Allreduce(MPI_IN_PLACE, values.data(), values.size(), MPI_DOUBLE,
+                      MPI_SUM, MPI_COMM_WORLD);
+    }
+#endif
+}
+
+
+template <class Cell>
+void EtaDomainT<Cell>::sum(const std::vector<double*> &values) const {
+    if (size_ == 1) return;
+    std::vector<double> buffer(values.size());
+    for (unsigned int i = 0; i < values.size(); i++) {
+        buffer[i] = *values[i];
+    }
+    sum(buffer);
+    for (unsigned int i = 0; i < values.size(); i++) {
+        *values[i] = buffer[i];
+    }
+}
+
+
+template class EtaDomainT<Cell_small>;
+template class EtaDomainT<Cell_ideal>;
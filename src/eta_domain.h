@@ -0,0 +1,101 @@
+#ifndef SRC_ETA_DOMAIN_H_
+#define SRC_ETA_DOMAIN_H_
+
+#ifdef MUSIC_MPI
+    #include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+#include "cell.h"
+#include "grid.h"
+#include "pretty_ostream.h"
+
+//! decomposition of the grid along eta over the MPI ranks (MUSIC built
+//! with -Dmpi=ON). Every rank only holds its own slab of eta rows and the
+//! halo rows around it (a grid made by distribute). The RK stages exchange
+//! the halos, the diagnostics are reduced over the ranks and the whole
+//! grid is only gathered on the root rank for the steps that write it.
+//! Without MPI the single rank owns the whole grid and every
+//! communication is a no-op.
+template <class Cell>
+class EtaDomainT {
+ private:
+    typedef GridT<Cell> Grid;
+
+    int rank_ = 0;
+    int size_ = 1;
+    //! eta rows of the input grid
+    int neta_;
+    //! first eta row of every rank, slab_begin_[size_] = neta_
+    std::vector<int> slab_begin_;
+    pretty_ostream music_message;
+
+#ifdef MUSIC_MPI
+    //! MPI type of one grid cell
+    MPI_Datatype cell_type_;
+#endif
+
+ public:
+    //! width of the halo of a slab, the eta reach of the KT stencil
+    static const int halo = 2;
+
+    explicit EtaDomainT(const int neta);
+    ~EtaDomainT();
+    EtaDomainT(const EtaDomainT&) = delete;
+    EtaDomainT& operator=(const EtaDomainT&) = delete;
+
+    int rank() const {return(rank_);}
+    int size() const {return(size_);}
+    bool is_root() const {return(rank_ == 0);}
+    int neta() const {return(neta_);}
+
+    //! the eta rows of the input grid held by this rank: its slab and the
+    //! halos inside the grid
+    int rows_begin() const {
+        return(std::max(0, slab_begin_[rank_] - halo));
+    }
+    int rows_end() const {
+        return(std::min(neta_, slab_begin_[rank_ + 1] + halo));
+    }
+
+    //! the eta rows [ieta_begin(), ieta_end()) of its grid evolved by this
+    //! rank
+    int ieta_begin() const {return(slab_begin_[rank_] - rows_begin());}
+    int ieta_end()   const {return(slab_begin_[rank_ + 1] - rows_begin());}
+
+    //! replaces the whole grid arena by the rows this rank holds
+    void distribute(Grid &arena) const;
+
+    //! copies the halo rows of the slab of this rank from the neighbouring
+    //! ranks
+    void exchange_halos(Grid &arena) const;
+
+    //! the whole grid on the root rank: arena itself on a single rank,
+    //! otherwise the slabs of all ranks gathered into buffer. Has to be
+    //! called by all ranks; the result is only valid on the root rank.
+    Grid& whole_grid(Grid &arena, Grid &buffer) const;
+
+    //! find_active_box over the grids of all ranks, with eta in the rows
+    //! of the input grid
+    GridBox active_box(const Grid &arena, const double eps_cut,
+                       const int margin) const;
+
+    //! the part of box (eta in the rows of the input grid) in the slab of
+    //! this rank, in the rows of its grid. The eta range is empty, but
+    //! keeps its position, if box lies outside of the slab.
+    GridBox slab_part(const GridBox &box) const;
+
+    //! maximum (minimum) of value over all ranks
+    int max(const int value) const;
+    double max(const double value) const;
+    double min(const double value) const;
+
+    //! sums every element of values over all ranks
+    void sum(std::vector<double> &values) const;
+    void sum(const std::vector<double*> &values) const;
+};
+
+typedef EtaDomainT<Cell_small> EtaDomain;
+
+#endif  // SRC_ETA_DOMAIN_H_
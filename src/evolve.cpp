@@ -24,12 +24,23 @@
 
 using Util::hbarc;
 
-Evolve::Evolve(const EOS &eosIn, const InitData &DATA_in,
-               std::shared_ptr<HydroSourceBase> hydro_source_ptr_in) :
-    eos(eosIn), DATA(DATA_in),
-    grid_info(DATA_in, eosIn), advance(eosIn, DATA_in, hydro_source_ptr_in) {
+template <class Cell>
+EvolveT<Cell>::EvolveT(const EOS &eosIn, InitData &DATA_in,
+                       std::shared_ptr<HydroSourceBase> hydro_source_ptr_in) :
+    eos(eosIn), DATA(DATA_in), domain(DATA_in.neta),
+    grid_info(DATA_in, eosIn, domain),
+    advance(eosIn, DATA_in, hydro_source_ptr_in),
+    u_derivative_helpers(DATA_in, eosIn),
+    derived_fields(u_derivative_helpers),
+    freezeout_derived_fields(u_derivative_helpers),
+    whole_grid_fields(u_derivative_helpers) {
 
     rk_order  = DATA_in.rk_order;
+    if (DATA.Initial_profile == 0) {
+        check_file_taus = {1.0, 1.2, 1.5, 2.0, 3.0};
+    } else if (DATA.Initial_profile == 1) {
+        check_file_taus = {1.0, 2.0, 5.0, 10.0, 20.0};
+    }
     if (DATA.freezeOutMethod == 4) {
         initialize_freezeout_surface_info();
     }
@@ -37,8 +48,9 @@ Evolve::Evolve(const EOS &eosIn, const InitData &DATA_in,
 }
 
 // master control function for hydrodynamic evolution
-int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
-                     SCGrid &arena_future, HydroinfoMUSIC &hydro_info_ptr) {
+template <class Cell>
+int EvolveT<Cell>::EvolveIt(Grid &arena_prev, Grid &arena_current,
+                            Grid &arena_future, HydroinfoMUSIC &hydro_info_ptr) {
     // first pass some control parameters
     facTau                      = DATA.facTau;
     int Nskip_timestep          = DATA.output_evolution_every_N_timesteps;
@@ -59,6 +71,21 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
     double tau0  = DATA.tau0;
     double dt    = DATA.delta_tau;
 
+    // with adaptive_time_step the number of steps is not known in advance;
+    // the steps end exactly on the evolution output times and on tau_end
+    const bool adaptive_dtau = (DATA.adaptive_time_step == 1);
+    const double tau_end = tau0 + itmax*dt;
+    delta_tau_initial       = dt;
+    DATA.delta_tau_prev     = dt;
+    DATA.delta_tau_output   = Nskip_timestep*dt;
+    freezeout_dtau          = facTau*dt;
+    freezeout_dtau_prev     = dt;
+    double tau_freezeout    = tau0;
+    const auto more_steps = [&](const int it, const double tau) {
+        if (adaptive_dtau) return(tau < tau_end + 0.5*DATA.delta_tau);
+        return(it <= itmax);
+    };
+
     double tau;
     int iFreezeStart = 0;
     double source_tau_max = 0.0;
@@ -77,44 +104,160 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
                   << " fm/c.";
     music_message.flush("info");
 
-    const auto closer = [](SCGrid* g) { /*Don't delete memory we don't own*/ };
+    // the initial conditions are set on the whole grid; every MPI rank
+    // keeps its own eta slab and the halos around it from here on
+    domain.distribute(arena_prev);
+    domain.distribute(arena_current);
+    domain.distribute(arena_future);
+
+    const auto closer = [](Grid* g) { /*Don't delete memory we don't own*/ };
     GridPointer ap_prev   (&arena_prev, closer);
     GridPointer ap_current(&arena_current, closer);
     GridPointer ap_future (&arena_future, closer);
 
-    SCGrid arena_freezeout_prev(arena_current.nX(),
-                                arena_current.nY(),
-                                arena_current.nEta());
-    SCGrid arena_freezeout(arena_current.nX(),
-                           arena_current.nY(),
-                           arena_current.nEta());
+    // freeze-out history. With facTau == 1 the last surface step is always
+    // *ap_prev, so it is read in place instead of being copied; the step
+    // before it is only needed for the vorticity output.
+    const bool store_freezeout      = (facTau > 1);
+    const bool store_freezeout_prev = (DATA.output_vorticity == 1);
+    Grid arena_freezeout_prev;
+    Grid arena_freezeout;
+    if (store_freezeout_prev) {
+        arena_freezeout_prev = Grid(arena_current.nX(), arena_current.nY(),
+                                    arena_current.nEta());
+    }
+    if (store_freezeout) {
+        arena_freezeout = Grid(arena_current.nX(), arena_current.nY(),
+                               arena_current.nEta());
+    }
+    // the whole grid gathered on the root rank for the outputs (unused on
+    // a single rank)
+    Grid whole_arena_current;
+    Grid whole_arena_prev;
+    // active box at the last freeze-out step
+    GridBox freezeout_box;
+    const auto update_freezeout_history = [&](const GridBox &box) {
+        freezeout_box = box;
+        tau_freezeout       = tau;
+        freezeout_dtau_prev = DATA.delta_tau_prev;
+        if (store_freezeout_prev) {
+            store_previous_step_for_freezeout(*ap_prev, arena_freezeout_prev);
+        }
+        if (store_freezeout) {
+            store_previous_step_for_freezeout(*ap_current, arena_freezeout);
+        }
+    };
 
     int it = 0;
+    bool grid_cropped = false;
     double eps_max_cur = -1.;
     const double max_allowed_e_increase_factor = 2.;
-    for (it = 0; it <= itmax; it++) {
-        tau = tau0 + dt*it;
+    tau = tau0;
+    for (it = 0; more_steps(it, tau); it++) {
+        if (!adaptive_dtau) {
+            tau = tau0 + dt*it;
+        }
+        // every MPI rank has only evolved its own eta slab
+        domain.exchange_halos(*ap_current);
 
         if (hydro_source_terms_ptr) {
             hydro_source_terms_ptr->prepare_list_for_current_tau_frame(tau);
         }
+        // the sources deposit on the input grid, so the grid is first
+        // cropped to a tight box around the fireball once they are done
+        if (DATA.expanding_grid == 1 && tau > source_tau_max) {
+            const auto k = transverse_grid_change(*ap_current,
+                                                  !grid_cropped);
+            grid_cropped = true;
+            if (k[0] != 0 || k[1] != 0) {
+                resize_transverse_grid(
+                    k[0], k[1], {ap_prev.get(), ap_current.get(),
+                                 ap_future.get(), &arena_freezeout_prev,
+                                 &arena_freezeout});
+                // shifted with the arenas and clipped to a cropped grid
+                if (freezeout_box.size() > 0) {
+                    const int n[2] = {ap_current->nX(), ap_current->nY()};
+                    for (int i = 0; i < 2; i++) {
+                        freezeout_box.lo[i] = std::max(
+                                    0, freezeout_box.lo[i] + k[i]);
+                        freezeout_box.hi[i] = std::min(
+                                    n[i], freezeout_box.hi[i] + k[i]);
+                    }
+                }
+            }
+        }
+        // the output and freeze-out routines below take derivatives
+        // on the current arena
+        ap_current->fill_ghost_cells();
+
+        // they and the first RK stage share the derivative fields at tau;
+        // the ones of the last freeze-out step are kept for the next one
+        if (derived_fields.tau() == tau_freezeout) {
+            std::swap(derived_fields, freezeout_derived_fields);
+        }
+        derived_fields.reset(ap_current->nX(), ap_current->nY(),
+                             ap_current->nEta(), tau);
+
+        // box around the fireball that is evolved and scanned this step
+        // (eta in the rows of the input grid); the margin covers the
+        // stencil reach of all RK stages
+        GridBox active_box(ap_current->nX(), ap_current->nY(),
+                           domain.neta());
+        if (DATA.active_region_eps_cut > 0. && tau > source_tau_max) {
+            active_box = domain.active_box(*ap_current,
+                                           DATA.active_region_eps_cut/hbarc,
+                                           2*rk_order + 2);
+        }
+        // its part in the slab of this rank
+        const GridBox slab_box = domain.slab_part(active_box);
+        advance.set_active_box(slab_box);
+
         // store initial conditions
         if (it == iFreezeStart) {
-            store_previous_step_for_freezeout(*ap_prev, arena_freezeout_prev);
-            store_previous_step_for_freezeout(*ap_current, arena_freezeout);
+            update_freezeout_history(active_box);
         }
 
-        if (DATA.Initial_profile == 0) {
-            if (   fabs(tau - 1.0) < 1e-8 || fabs(tau - 1.2) < 1e-8
-                || fabs(tau - 1.5) < 1e-8 || fabs(tau - 2.0) < 1e-8
-                || fabs(tau - 3.0) < 1e-8) {
-                grid_info.Gubser_flow_check_file(*ap_current, tau);
+        // the outputs of the whole grid are written by the root rank,
+        // which gathers the slabs of all ranks only for the steps that
+        // write one
+        bool check_file_step = false;
+        for (const auto tau_check : check_file_taus) {
+            check_file_step = check_file_step || fabs(tau - tau_check) < 1e-8;
+        }
+        const bool output_step = (
+            adaptive_dtau
+            ? std::abs(std::remainder(tau - tau0, DATA.delta_tau_output)) < 1e-8
+            : it % Nskip_timestep == 0);
+        const bool anisotropy_step = (
+               it == iFreezeStart || it == iFreezeStart + 10
+            || it == iFreezeStart + 30 || it == iFreezeStart + 50);
+        const bool vorticity_step = (
+            !DATA.boost_invariant && DATA.output_vorticity
+            && (   fabs(tau -  1.0) < 1e-8 || fabs(tau -  2.0) < 1e-8
+                || fabs(tau -  5.0) < 1e-8 || fabs(tau - 10.0) < 1e-8));
+        Grid *whole_current = ap_current.get();
+        Grid *whole_prev    = ap_prev.get();
+        DerivedFieldSliceT<Cell> *whole_fields = &derived_fields;
+        if (   check_file_step || (output_step && has_evolution_output())
+            || anisotropy_step || vorticity_step) {
+            whole_current = &domain.whole_grid(*ap_current,
+                                               whole_arena_current);
+            if (   vorticity_step
+                || (output_step && DATA.outputEvolutionData == 4)) {
+                whole_prev = &domain.whole_grid(*ap_prev, whole_arena_prev);
+            }
+            if (domain.size() > 1) {
+                whole_fields = &whole_grid_fields;
+                whole_fields->reset(whole_current->nX(), whole_current->nY(),
+                                    whole_current->nEta(), tau);
             }
-        } else if (DATA.Initial_profile == 1) {
-            if (   fabs(tau -  1.0) < 1e-8 || fabs(tau -  2.0) < 1e-8
-                || fabs(tau -  5.0) < 1e-8 || fabs(tau - 10.0) < 1e-8
-                || fabs(tau - 20.0) < 1e-8) {
-                grid_info.output_1p1D_check_file(*ap_current, tau);
+        }
+
+        if (check_file_step && domain.is_root()) {
+            if (DATA.Initial_profile == 0) {
+                grid_info.Gubser_flow_check_file(*whole_current, tau);
+            } else {
+                grid_info.output_1p1D_check_file(*whole_current, tau);
             }
         }
 
@@ -126,37 +269,43 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
         //    }
         //}
 
-        if (it % Nskip_timestep == 0) {
+        if (output_step && domain.is_root()) {
             if (DATA.outputEvolutionData == 1) {
-                grid_info.OutputEvolutionDataXYEta(*ap_current, tau);
+                grid_info.OutputEvolutionDataXYEta(*whole_current, tau);
             } else if (DATA.outputEvolutionData == 2) {
-                grid_info.OutputEvolutionDataXYEta_chun(*ap_current, tau);
+                grid_info.OutputEvolutionDataXYEta_chun(*whole_current, tau);
             } else if (DATA.outputEvolutionData == 3) {
-                grid_info.OutputEvolutionDataXYEta_photon(*ap_current, tau);
+                grid_info.OutputEvolutionDataXYEta_photon(*whole_current, tau);
             } else if (DATA.outputEvolutionData == 4) {
                 grid_info.OutputEvolutionDataXYEta_vorticity(
-                                            *ap_current, *ap_prev, tau);
+                            *whole_current, *whole_prev, *whole_fields, tau);
             }
 
             if (DATA.output_movie_flag == 1) {
-                grid_info.output_evolution_for_movie(*ap_current, tau);
+                grid_info.output_evolution_for_movie(*whole_current, tau);
             }
 
             if (DATA.store_hydro_info_in_memory == 1) {
-                grid_info.OutputEvolutionDataXYEta_memory(*ap_current, tau,
+                grid_info.OutputEvolutionDataXYEta_memory(*whole_current, tau,
                                                           hydro_info_ptr);
             }
 
             if (DATA.output_outofequilibriumsize == 1) {
-                grid_info.OutputEvolution_Knudsen_Reynoldsnumbers(*ap_current,
-                                                                  tau);
+                grid_info.OutputEvolution_Knudsen_Reynoldsnumbers(
+                                                        *whole_current, tau);
             }
         }
 
-        if (it == iFreezeStart || it == iFreezeStart + 10
-            || it == iFreezeStart + 30 || it == iFreezeStart + 50) {
-            grid_info.output_momentum_anisotropy_vs_etas(tau, *ap_current);
+        if (anisotropy_step && domain.is_root()) {
+            grid_info.output_momentum_anisotropy_vs_etas(tau, *whole_current);
+        }
+        if (vorticity_step && domain.is_root()) {
+            grid_info.output_vorticity_distribution(
+                            *whole_current, *whole_prev, *whole_fields,
+                            tau, -0.5, 0.5);
         }
+
+        // the diagnostics below are reduced over the slabs of all ranks
         grid_info.output_momentum_anisotropy_vs_tau(
                                             tau, -0.5, 0.5, *ap_current);
         if (DATA.Initial_profile == 13) {
@@ -172,30 +321,27 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
                                             tau, 4.0, 5.0, *ap_current);
         }
 
-
         // check energy conservation
         if (!DATA.boost_invariant) {
-            grid_info.check_conservation_law(*ap_current, *ap_prev, tau);
+            grid_info.check_conservation_law(*ap_current, *ap_prev, tau,
+                                             slab_box);
             if (DATA.output_vorticity) {
-                if (   fabs(tau -  1.0) < 1e-8 || fabs(tau -  2.0) < 1e-8
-                    || fabs(tau -  5.0) < 1e-8 || fabs(tau - 10.0) < 1e-8) {
-                    grid_info.output_vorticity_distribution(
-                                    *ap_current, *ap_prev, tau, -0.5, 0.5);
-                }
                 grid_info.compute_angular_momentum(
                                     *ap_current, *ap_prev, tau, -0.5, 0.5);
                 grid_info.output_vorticity_time_evolution(
-                                    *ap_current, *ap_prev, tau, -0.5, 0.5);
+                                    *ap_current, *ap_prev, derived_fields,
+                                    tau, -0.5, 0.5);
                 grid_info.compute_angular_momentum(
                                     *ap_current, *ap_prev, tau, -1.0, 1.0);
                 grid_info.output_vorticity_time_evolution(
-                                    *ap_current, *ap_prev, tau, -1.0, 1.0);
+                                    *ap_current, *ap_prev, derived_fields,
+                                    tau, -1.0, 1.0);
                 grid_info.compute_angular_momentum(
                                     *ap_current, *ap_prev, tau,
                                     -DATA.eta_size/2., DATA.eta_size/2.);
                 grid_info.output_vorticity_time_evolution(
-                                    *ap_current, *ap_prev, tau,
-                                    -DATA.eta_size/2., DATA.eta_size/2.);
+                                    *ap_current, *ap_prev, derived_fields,
+                                    tau, -DATA.eta_size/2., DATA.eta_size/2.);
             }
         }
 
@@ -221,9 +367,9 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
             }
         }
 
-        if (DATA.output_hydro_debug_info == 1) {
+        if (DATA.output_hydro_debug_info == 1 && domain.is_root()) {
             grid_info.monitor_a_fluid_cell(*ap_current, *ap_prev,
-                                           100, 100, 0, tau);
+                                           derived_fields, 100, 100, 0, tau);
         }
 
         //determine freeze-out surface
@@ -234,29 +380,53 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
             }
             // avoid freeze-out at the first time step
             if ((it - iFreezeStart)%facTau == 0 && it > iFreezeStart) {
+                Grid &arena_freezeout_last = (
+                        store_freezeout ? arena_freezeout : *ap_prev);
+                if (adaptive_dtau) {
+                    freezeout_dtau = tau - tau_freezeout;
+                }
+                // a surface can only cross cells that were active at
+                // either end of the freeze-out time step
+                GridBox scan_box = active_box;
+                scan_box.extend(freezeout_box);
+                scan_box = domain.slab_part(scan_box);
                 if (!DATA.boost_invariant) {
                     frozen = FindFreezeOutSurface_Cornelius(
                                 tau, *ap_prev, *ap_current,
-                                arena_freezeout_prev, arena_freezeout);
+                                arena_freezeout_prev, arena_freezeout_last,
+                                scan_box);
                 } else {
                     frozen = FindFreezeOutSurface_boostinvariant_Cornelius(
-                                tau, *ap_current, arena_freezeout);
+                                tau, *ap_current, arena_freezeout_last,
+                                scan_box);
                 }
-                store_previous_step_for_freezeout(*ap_prev,
-                                                  arena_freezeout_prev);
-                store_previous_step_for_freezeout(*ap_current,
-                                                  arena_freezeout);
+                update_freezeout_history(active_box);
             }
+            frozen = domain.max(frozen);
+        }
+
+        if (adaptive_dtau && tau > source_tau_max) {
+            DATA.delta_tau = adaptive_time_step(
+                        tau, *ap_current, next_stop_tau(tau, tau_end));
         }
 
         /* execute rk steps */
         // all the evolution are at here !!!
+        advance.set_first_stage_fields(
+                derived_fields.size() > 0 ? &derived_fields : nullptr);
         AdvanceRK(tau, ap_prev, ap_current, ap_future);
+        advance.set_first_stage_fields(nullptr);
 
         music_message << emoji::clock()
                       << " Done time step " << it << "/" << itmax
                       << " tau = " << tau << " fm/c";
+        if (adaptive_dtau) {
+            music_message << ", dtau = " << DATA.delta_tau << " fm/c";
+        }
         music_message.flush("info");
+        if (adaptive_dtau) {
+            tau += DATA.delta_tau;
+        }
         if (frozen == 1 && tau > source_tau_max) {
             if (   DATA.outputEvolutionData == 2
                 || DATA.outputEvolutionData == 3) {
@@ -280,7 +450,7 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
             }
         }
     }
-    if (it < itmax) {
+    if (adaptive_dtau ? more_steps(it, tau) : it < itmax) {
         music_message.info("Finished.");
     } else {
         music_message.warning("Maximum allowed time reached.");
@@ -288,8 +458,104 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
     return 1;
 }
 
-void Evolve::store_previous_step_for_freezeout(SCGrid &arena_current,
-                                               SCGrid &arena_freezeout) {
+template <class Cell>
+double EvolveT<Cell>::adaptive_time_step(const double tau,
+                                         const Grid &arena_current,
+                                         const double tau_stop) {
+    double dtau_cfl, dtau_relax;
+    advance.MaxTimeSteps(tau, arena_current, dtau_cfl, dtau_relax);
+    dtau_cfl   = domain.min(dtau_cfl);
+    dtau_relax = domain.min(dtau_relax);
+    // the source terms limit the relaxation times to >= 3 delta_tau, which
+    // the fixed-step runs accept for Delta_Tau, so the relaxation times
+    // never shorten the step below it
+    double dtau = std::min(dtau_cfl, std::max(dtau_relax, delta_tau_initial));
+    dtau = std::min(dtau, 1.2*DATA.delta_tau);
+    dtau = std::min(dtau, DATA.delta_tau_max);
+    const double n_steps = std::ceil((tau_stop - tau)/dtau - 1e-6);
+    if (n_steps >= 1.) {
+        dtau = (tau_stop - tau)/n_steps;
+    }
+    return(dtau);
+}
+
+template <class Cell>
+double EvolveT<Cell>::next_stop_tau(const double tau,
+                                    const double tau_end) const {
+    const double eps = 1e-8;
+    double tau_stop = tau_end;
+    if (has_evolution_output()) {
+        const double n_output = std::floor(
+                (tau - DATA.tau0 + eps)/DATA.delta_tau_output) + 1.;
+        tau_stop = std::min(tau_stop,
+                            DATA.tau0 + n_output*DATA.delta_tau_output);
+    }
+    for (const auto tau_check : check_file_taus) {
+        if (tau_check > tau + eps) {
+            tau_stop = std::min(tau_stop, tau_check);
+        }
+    }
+    return(tau_stop);
+}
+
+template <class Cell>
+bool EvolveT<Cell>::has_evolution_output() const {
+    return(   DATA.outputEvolutionData != 0 || DATA.output_movie_flag == 1
+           || DATA.store_hydro_info_in_memory == 1
+           || DATA.output_outofequilibriumsize == 1);
+}
+
+//! number of cells to add on each side of the transverse grid (negative:
+//! to remove) so that the fireball keeps DATA.expanding_grid_buffer cells
+//! away from the edge. During the evolution (initial = false) the grid
+//! only grows, by expanding_grid_buffer cells at a time, and never beyond
+//! the input grid size.
+template <class Cell>
+std::array<int, 2> EvolveT<Cell>::transverse_grid_change(
+                        const Grid &arena, const bool initial) const {
+    std::array<int, 2> k = {{0, 0}};
+    const GridBox box = domain.active_box(
+                arena, DATA.expanding_grid_eps_cut/hbarc, 0);
+    if (box.size() == 0) return(k);
+    const int buffer = DATA.expanding_grid_buffer;
+    const int n[2]     = {arena.nX(), arena.nY()};
+    const int n_max[2] = {DATA.nx, DATA.ny};
+    for (int i = 0; i < 2; i++) {
+        const int free_cells = std::min(box.lo[i], n[i] - box.hi[i]);
+        if (initial) {
+            k[i] = buffer - free_cells;
+        } else if (free_cells < buffer) {
+            k[i] = buffer;
+        }
+        k[i] = std::min(k[i], (n_max[i] - n[i])/2);
+    }
+    return(k);
+}
+
+//! adds kx (ky) cells on both sides of the transverse grid (removes them
+//! if negative) in every non-empty arena. DATA keeps the input grid; the
+//! arenas know where they lie in it (GridT::ix_input), so the cell spacing
+//! and the coordinates of every cell stay the same.
+template <class Cell>
+void EvolveT<Cell>::resize_transverse_grid(const int kx, const int ky,
+                                           const std::vector<Grid*> &arenas) {
+    if (kx == 0 && ky == 0) return;
+    for (auto arena : arenas) {
+        if (arena->size() > 0) {
+            *arena = arena->transverse_resized(kx, ky);
+        }
+    }
+    const Grid &arena = *arenas[0];
+    music_message << "expanding grid: nx = " << arena.nX()
+                  << ", ny = " << arena.nY() << ", x_size = "
+                  << (arena.nX() - 1)*DATA.delta_x << " fm, y_size = "
+                  << (arena.nY() - 1)*DATA.delta_y << " fm.";
+    music_message.flush("info");
+}
+
+template <class Cell>
+void EvolveT<Cell>::store_previous_step_for_freezeout(Grid &arena_current,
+                                                      Grid &arena_freezeout) {
     const int nx   = arena_current.nX();
     const int ny   = arena_current.nY();
     const int neta = arena_current.nEta();
@@ -301,12 +567,20 @@ void Evolve::store_previous_step_for_freezeout(SCGrid &arena_current,
     }
 }
 
-void Evolve::AdvanceRK(double tau, GridPointer &arena_prev, GridPointer &arena_current, GridPointer &arena_future) {
+template <class Cell>
+void EvolveT<Cell>::AdvanceRK(double tau, GridPointer &arena_prev, GridPointer &arena_current, GridPointer &arena_future) {
     // control function for Runge-Kutta evolution in tau
     // loop over Runge-Kutta steps
+    // after the first stage arena_prev holds u^n at tau for all later
+    // stages, which overwrite the free arena_future in turn
     for (int rk_flag = 0; rk_flag < rk_order; rk_flag++) {
         advance.AdvanceIt(tau, *arena_prev, *arena_current, *arena_future,
-                          rk_flag);
+                          rk_flag, domain.ieta_begin(), domain.ieta_end());
+        // the halos of the last stage are exchanged at the start of the
+        // next time step
+        if (rk_flag < rk_order - 1) {
+            domain.exchange_halos(*arena_future);
+        }
         if (rk_flag == 0) {
             auto temp     = std::move(arena_prev);
             arena_prev    = std::move(arena_current);
@@ -315,44 +589,154 @@ void Evolve::AdvanceRK(double tau, GridPointer &arena_prev, GridPointer &arena_c
         } else {
             std::swap(arena_current, arena_future);
         }
+        // the next stage differentiates between tau and the time of its
+        // input state
+        DATA.delta_tau_prev = (
+            get_rk_stage(rk_order, rk_flag).c_out*DATA.delta_tau);
     }  /* loop over rk_flag */
 }
 
 // Cornelius freeze out  (C. Shen, 11/2014)
-int Evolve::FindFreezeOutSurface_Cornelius(double tau,
-        SCGrid &arena_prev, SCGrid &arena_current,
-        SCGrid &arena_freezeout_prev, SCGrid &arena_freezeout) {
+template <class Cell>
+int EvolveT<Cell>::FindFreezeOutSurface_Cornelius(double tau,
+        Grid &arena_prev, Grid &arena_current,
+        Grid &arena_freezeout_prev, Grid &arena_freezeout,
+        const GridBox &box) {
     const int neta = arena_current.nEta();
     const int fac_eta = 1;
+    // every MPI rank scans the cubes starting in its own eta slab
+    const int ieta_start = std::max(std::max(0, box.lo[2] - fac_eta),
+                                    domain.ieta_begin());
+    const int ieta_end   = std::min(std::min(neta - fac_eta, box.hi[2]),
+                                    domain.ieta_end());
+    if (DATA.output_vorticity == 1) {
+        prepare_freezeout_aux(tau, arena_prev, arena_current,
+                              arena_freezeout_prev, arena_freezeout, box);
+    }
+
     int intersections = 0;
     for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf; i_freezesurf++) {
         const double epsFO = epsFO_list[i_freezesurf]/hbarc;   // 1/fm^4
 
         #pragma omp parallel for reduction(+:intersections)
-        for (int ieta = 0; ieta < (neta-fac_eta); ieta += fac_eta) {
+        for (int ieta = ieta_start; ieta < ieta_end; ieta += fac_eta) {
             int thread_id = omp_get_thread_num();
             intersections += FindFreezeOutSurface_Cornelius_XY(
                 tau, ieta, arena_prev, arena_current,
-                arena_freezeout_prev, arena_freezeout, thread_id, epsFO);
+                arena_freezeout_prev, arena_freezeout, box, thread_id, epsFO);
         }
     }
 
     return(intersections + 1);
 }
 
-int Evolve::FindFreezeOutSurface_Cornelius_XY(double tau, int ieta,
-                                              SCGrid &arena_prev,
-                                              SCGrid &arena_current,
-                                              SCGrid &arena_freezeout_prev,
-                                              SCGrid &arena_freezeout,
-                                              int thread_id, double epsFO) {
+template <class Cell>
+void EvolveT<Cell>::prepare_freezeout_aux(double tau,
+        Grid &arena_prev, Grid &arena_current,
+        Grid &arena_freezeout_prev, Grid &arena_freezeout,
+        const GridBox &box) {
+    const int nx   = arena_current.nX();
+    const int ny   = arena_current.nY();
+    const int neta = arena_current.nEta();
+    const int fac_x   = DATA.fac_x;
+    const int fac_y   = DATA.fac_y;
+    const int fac_eta = 1;
+    const double DTAU = freezeout_dtau;
+
+    if (   !freezeout_derived_fields.fits(nx, ny, neta)
+        || std::abs(freezeout_derived_fields.tau() - (tau - DTAU))
+           > 0.5*DATA.delta_tau) {
+        freezeout_derived_fields.reset(nx, ny, neta, tau - DTAU);
+    }
+
+    // corners of the crossed hypercubes (the cubes and corner cells of
+    // FindFreezeOutSurface_Cornelius_XY); the slices skip the ones they
+    // already hold
+    const int ieta_start = std::max(std::max(0, box.lo[2] - fac_eta),
+                                    domain.ieta_begin());
+    const int ieta_end   = std::min(std::min(neta - fac_eta, box.hi[2]),
+                                    domain.ieta_end());
+    const int ix_start = (std::max(0, box.lo[0] - fac_x)/fac_x)*fac_x;
+    const int iy_start = (std::max(0, box.lo[1] - fac_y)/fac_y)*fac_y;
+    const int ix_end   = std::min(nx - fac_x, box.hi[0]);
+    const int iy_end   = std::min(ny - fac_y, box.hi[1]);
+    freezeout_corners.clear();
+    for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf; i_freezesurf++) {
+        const double epsFO = epsFO_list[i_freezesurf]/hbarc;
+        for (int ieta = ieta_start; ieta < ieta_end; ieta += fac_eta)
+        for (int ix = ix_start; ix < ix_end; ix += fac_x)
+        for (int iy = iy_start; iy < iy_end; iy += fac_y) {
+            if (!hypercube_crosses(arena_current, arena_freezeout,
+                                   ix, iy, ieta, fac_x, fac_y, fac_eta,
+                                   epsFO)) {
+                continue;
+            }
+            for (int ii = 0; ii < 2; ii++)
+            for (int jj = 0; jj < 2; jj++)
+            for (int kk = 0; kk < 2; kk++) {
+                freezeout_corners.push_back(derived_fields.cell_index(
+                    ix + ii*fac_x, iy + jj*fac_y, ieta + kk*fac_eta));
+            }
+        }
+    }
+
+    // the time derivatives of the freeze-out slice span the step before it
+    derived_fields.add(DATA.delta_tau_prev, arena_prev, arena_current,
+                       freezeout_corners);
+    freezeout_derived_fields.add(freezeout_dtau_prev, arena_freezeout_prev,
+                                 arena_freezeout, freezeout_corners);
+}
+
+
+//! whether the epsFO surface crosses the hypercube spanned by
+//! (ix, iy, ieta) and (ix + fac_x, iy + fac_y, ieta + fac_eta) between the
+//! freeze-out and the current time slice (from Bjoern)
+template <class Cell>
+bool EvolveT<Cell>::hypercube_crosses(const Grid &arena_current,
+                                      const Grid &arena_freezeout,
+                                      const int ix, const int iy,
+                                      const int ieta, const int fac_x,
+                                      const int fac_y, const int fac_eta,
+                                      const double epsFO) const {
+    int intersect = 1;
+    if ((arena_current(ix+fac_x,iy+fac_y,ieta+fac_eta).epsilon-epsFO)
+        *(arena_freezeout(ix,iy,ieta).epsilon-epsFO)>0.)
+        if((arena_current(ix+fac_x,iy,ieta).epsilon-epsFO)
+            *(arena_freezeout(ix,iy+fac_y,ieta+fac_eta).epsilon-epsFO)>0.)
+            if((arena_current(ix,iy+fac_y,ieta).epsilon-epsFO)
+                *(arena_freezeout(ix+fac_x,iy,ieta+fac_eta).epsilon-epsFO)>0.)
+                if((arena_current(ix,iy,ieta+fac_eta).epsilon-epsFO)
+                    *(arena_freezeout(ix+fac_x,iy+fac_y,ieta).epsilon-epsFO)>0.)
+                    if((arena_current(ix+fac_x,iy+fac_y,ieta).epsilon-epsFO)
+                        *(arena_freezeout(ix,iy,ieta+fac_eta).epsilon-epsFO)>0.)
+                        if((arena_current(ix+fac_x,iy,ieta+fac_eta).epsilon-epsFO)
+                            *(arena_freezeout(ix,iy+fac_y,ieta).epsilon-epsFO)>0.)
+                            if((arena_current(ix,iy+fac_y,ieta+fac_eta).epsilon-epsFO)
+                                *(arena_freezeout(ix+fac_x,iy,ieta).epsilon-epsFO)>0.)
+                                if((arena_current(ix,iy,ieta).epsilon-epsFO)
+                                    *(arena_freezeout(ix+fac_x,iy+fac_y,ieta+fac_eta).epsilon-epsFO)>0.)
+                                        intersect=0;
+    return(intersect == 1);
+}
+
+template <class Cell>
+int EvolveT<Cell>::FindFreezeOutSurface_Cornelius_XY(double tau, int ieta,
+                                                     Grid &arena_prev,
+                                                     Grid &arena_current,
+                                                     Grid &arena_freezeout_prev,
+                                                     Grid &arena_freezeout,
+                                                     const GridBox &box,
+                                                     int thread_id, double epsFO) {
     const bool surface_in_binary = DATA.freeze_surface_in_binary;
     const int nx = arena_current.nX();
     const int ny = arena_current.nY();
 
     std::stringstream strs_name;
-    strs_name << "surface_eps_" << std::setprecision(4) << epsFO*hbarc
-              << "_" << thread_id << ".dat";
+    strs_name << "surface_eps_" << std::setprecision(4) << epsFO*hbarc;
+    if (domain.size() > 1) {
+        strs_name << "_rank" << domain.rank();
+    }
+    strs_name << "_" << thread_id << ".dat";
     std::ofstream s_file;
     std::ios_base::openmode modes;
 
@@ -371,13 +755,11 @@ int Evolve::FindFreezeOutSurface_Cornelius_XY(double tau, int ieta,
     int fac_y   = DATA.fac_y;
     int fac_eta = 1;
 
-    const double DTAU = facTau*DATA.delta_tau;
+    const double DTAU = freezeout_dtau;
     const double DX   = fac_x*DATA.delta_x;
     const double DY   = fac_y*DATA.delta_y;
     const double DETA = fac_eta*DATA.delta_eta;
 
-    U_derivative u_derivative_helper(DATA, eos);
-
     // initialize Cornelius
     double lattice_spacing[4] = {DTAU, DX, DY, DETA};
     std::shared_ptr<Cornelius> cornelius_ptr(new Cornelius());
@@ -405,34 +787,27 @@ int Evolve::FindFreezeOutSurface_Cornelius_XY(double tau, int ieta,
         }
     }
 
+    // cubes touching the scan box, on the fac_x*fac_y lattice
+    const int ix_start = (std::max(0, box.lo[0] - fac_x)/fac_x)*fac_x;
+    const int iy_start = (std::max(0, box.lo[1] - fac_y)/fac_y)*fac_y;
+    const int ix_end   = std::min(nx - fac_x, box.hi[0]);
+    const int iy_end   = std::min(ny - fac_y, box.hi[1]);
+
     double x_fraction[2][4];
-    double eta = (DATA.delta_eta)*ieta - (DATA.eta_size)/2.0;
-    for (int ix = 0; ix < nx - fac_x; ix += fac_x) {
-        double x = ix*(DATA.delta_x) - (DATA.x_size/2.0);
-        for (int iy = 0; iy < ny - fac_y; iy += fac_y) {
-            double y = iy*(DATA.delta_y) - (DATA.y_size/2.0);
-
-            // judge intersection (from Bjoern)
-            int intersect = 1;
-            if ((arena_current(ix+fac_x,iy+fac_y,ieta+fac_eta).epsilon-epsFO)
-                *(arena_freezeout(ix,iy,ieta).epsilon-epsFO)>0.)
-                if((arena_current(ix+fac_x,iy,ieta).epsilon-epsFO)
-                    *(arena_freezeout(ix,iy+fac_y,ieta+fac_eta).epsilon-epsFO)>0.)
-                    if((arena_current(ix,iy+fac_y,ieta).epsilon-epsFO)
-                        *(arena_freezeout(ix+fac_x,iy,ieta+fac_eta).epsilon-epsFO)>0.)
-                        if((arena_current(ix,iy,ieta+fac_eta).epsilon-epsFO)
-                            *(arena_freezeout(ix+fac_x,iy+fac_y,ieta).epsilon-epsFO)>0.)
-                            if((arena_current(ix+fac_x,iy+fac_y,ieta).epsilon-epsFO)
-                                *(arena_freezeout(ix,iy,ieta+fac_eta).epsilon-epsFO)>0.)
-                                if((arena_current(ix+fac_x,iy,ieta+fac_eta).epsilon-epsFO)
-                                    *(arena_freezeout(ix,iy+fac_y,ieta).epsilon-epsFO)>0.)
-                                    if((arena_current(ix,iy+fac_y,ieta+fac_eta).epsilon-epsFO)
-                                        *(arena_freezeout(ix+fac_x,iy,ieta).epsilon-epsFO)>0.)
-                                        if((arena_current(ix,iy,ieta).epsilon-epsFO)
-                                            *(arena_freezeout(ix+fac_x,iy+fac_y,ieta+fac_eta).epsilon-epsFO)>0.)
-                                                intersect=0;
-
-            if (intersect==0) continue;
+    double eta = ((DATA.delta_eta)*arena_current.ieta_input(ieta)
+                  - (DATA.eta_size)/2.0);
+    for (int ix = ix_start; ix < ix_end; ix += fac_x) {
+        double x = (arena_current.ix_input(ix)*(DATA.delta_x)
+                    - (DATA.x_size/2.0));
+        for (int iy = iy_start; iy < iy_end; iy += fac_y) {
+            double y = (arena_current.iy_input(iy)*(DATA.delta_y)
+                        - (DATA.y_size/2.0));
+
+            if (!hypercube_crosses(arena_current, arena_freezeout,
+                                   ix, iy, ieta, fac_x, fac_y, fac_eta,
+                                   epsFO)) {
+                continue;
+            }
                 
             if (ix == 0 || ix >= nx - 2*fac_x
                     || iy == 0 || iy >= ny - 2*fac_y) {
@@ -532,25 +907,18 @@ int Evolve::FindFreezeOutSurface_Cornelius_XY(double tau, int ieta,
 
                     if (DATA.output_vorticity == 0) continue;
 
-                    // compute the vorticity tensors
-                    Cell_aux aux_tmp;
-                    double eta_local = eta + kk*DETA;
-                    u_derivative_helper.compute_vorticity_shell(
-                        tau, arena_prev, arena_current,
-                        ieta + kk*fac_eta, ix + ii*fac_eta, iy + jj*fac_eta,
-                        eta_local,
-                        aux_tmp.omega_kSP, aux_tmp.omega_k,
-                        aux_tmp.omega_th, aux_tmp.omega_T,
-                        aux_tmp.sigma, aux_tmp.DbetaMu);
-                    fluid_aux_cube[1][ii][jj][kk] = aux_tmp;
-                    u_derivative_helper.compute_vorticity_shell(
-                        tau - DTAU, arena_freezeout_prev, arena_freezeout,
-                        ieta + kk*fac_eta, ix + ii*fac_eta, iy + jj*fac_eta,
-                        eta_local,
-                        aux_tmp.omega_kSP, aux_tmp.omega_k,
-                        aux_tmp.omega_th, aux_tmp.omega_T,
-                        aux_tmp.sigma, aux_tmp.DbetaMu);
-                    fluid_aux_cube[0][ii][jj][kk] = aux_tmp;
+                    // vorticity tensors from prepare_freezeout_aux
+                    const int ix_c   = ix + ii*fac_x;
+                    const int iy_c   = iy + jj*fac_y;
+                    const int ieta_c = ieta + kk*fac_eta;
+                    const double eta_c = (
+                        (DATA.delta_eta)*arena_current.ieta_input(ieta_c)
+                        - (DATA.eta_size)/2.0);
+                    fluid_aux_cube[1][ii][jj][kk] = derived_fields.tz(
+                                                ix_c, iy_c, ieta_c, eta_c);
+                    fluid_aux_cube[0][ii][jj][kk] = (
+                        freezeout_derived_fields.tz(ix_c, iy_c, ieta_c,
+                                                    eta_c));
                 }
                 auto fluid_center = four_dimension_linear_interpolation(
                         lattice_spacing, x_fraction, fluid_cube);
@@ -598,19 +966,20 @@ int Evolve::FindFreezeOutSurface_Cornelius_XY(double tau, int ieta,
                 fluid_center.Wmunu[9] = Wmunu_regulated[3][3];
 
                 // 4-dimension interpolation done
-                const double TFO = eos.get_temperature(epsFO,
-                                                       fluid_center.rhob);
+                const EOSThermo thermo = eos.get_thermo(
+                                        epsFO, fluid_center.rhob, false);
+                const double TFO = thermo.T;
                 if (TFO < 0) {
                     music_message << "TFO=" << TFO
                                   << "<0. ERROR. exiting.";
                     music_message.flush("error");
                     exit(1);
                 }
-                const double muB = eos.get_muB(epsFO, fluid_center.rhob);
-                const double muS = eos.get_muS(epsFO, fluid_center.rhob);
-                const double muC = eos.get_muC(epsFO, fluid_center.rhob);
+                const double muB = thermo.muB;
+                const double muS = thermo.muS;
+                const double muC = thermo.muC;
 
-                const double pressure = eos.get_pressure(epsFO, fluid_center.rhob);
+                const double pressure = thermo.pressure;
                 const double eps_plus_p_over_T_FO = (epsFO + pressure)/TFO;
 
                 // finally output results !!!!
@@ -709,19 +1078,23 @@ int Evolve::FindFreezeOutSurface_Cornelius_XY(double tau, int ieta,
 
 
 // Cornelius freeze out (C. Shen, 11/2014)
-int Evolve::FreezeOut_equal_tau_Surface(double tau,
-                                        SCGrid &arena_current) {
+template <class Cell>
+int EvolveT<Cell>::FreezeOut_equal_tau_Surface(double tau,
+                                               Grid &arena_current) {
     // this function freeze-out fluid cells between epsFO and epsFO_low
     // on an equal time hyper-surface at the first time step
     // this function will be trigged if freezeout_lowtemp_flag == 1
     const int neta = arena_current.nEta();
     const int fac_eta = 1;
+    // every MPI rank writes the cells of its own eta slab
+    const int ieta_end = std::min(neta - fac_eta, domain.ieta_end());
 
     for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf; i_freezesurf++) {
         double epsFO = epsFO_list[i_freezesurf]/hbarc;
         if (!DATA.boost_invariant) {
             #pragma omp parallel for
-            for (int ieta = 0; ieta < neta - fac_eta; ieta += fac_eta) {
+            for (int ieta = domain.ieta_begin(); ieta < ieta_end;
+                 ieta += fac_eta) {
                 int thread_id = omp_get_thread_num();
                 FreezeOut_equal_tau_Surface_XY(tau,  ieta, arena_current,
                                                thread_id, epsFO);
@@ -734,9 +1107,10 @@ int Evolve::FreezeOut_equal_tau_Surface(double tau,
 }
 
 
-void Evolve::FreezeOut_equal_tau_Surface_XY(double tau, int ieta,
-                                            SCGrid &arena_current,
-                                            int thread_id, double epsFO) {
+template <class Cell>
+void EvolveT<Cell>::FreezeOut_equal_tau_Surface_XY(double tau, int ieta,
+                                                   Grid &arena_current,
+                                                   int thread_id, double epsFO) {
     const bool surface_in_binary = DATA.freeze_surface_in_binary;
     double epsFO_low = 0.05/hbarc;        // 1/fm^4
 
@@ -745,8 +1119,11 @@ void Evolve::FreezeOut_equal_tau_Surface_XY(double tau, int ieta,
 
     std::stringstream strs_name;
     if (!DATA.boost_invariant) {
-        strs_name << "surface_eps_" << std::setprecision(4) << epsFO*hbarc
-                  << "_" << thread_id << ".dat";
+        strs_name << "surface_eps_" << std::setprecision(4) << epsFO*hbarc;
+        if (domain.size() > 1) {
+            strs_name << "_rank" << domain.rank();
+        }
+        strs_name << "_" << thread_id << ".dat";
     } else {
         strs_name << "surface_eps_" << std::setprecision(4) << epsFO*hbarc
                   << ".dat";
@@ -769,11 +1146,14 @@ void Evolve::FreezeOut_equal_tau_Surface_XY(double tau, int ieta,
     const double DY   = fac_y*DATA.delta_y;
     const double DETA = fac_eta*DATA.delta_eta;
 
-    double eta = (DATA.delta_eta)*ieta - (DATA.eta_size)/2.0;
+    double eta = ((DATA.delta_eta)*arena_current.ieta_input(ieta)
+                  - (DATA.eta_size)/2.0);
     for (int ix = 0; ix < nx - fac_x; ix += fac_x) {
-        double x = ix*(DATA.delta_x) - (DATA.x_size/2.0); 
+        double x = (arena_current.ix_input(ix)*(DATA.delta_x)
+                    - (DATA.x_size/2.0));
         for (int iy = 0; iy < ny - fac_y; iy += fac_y) {
-            double y = iy*(DATA.delta_y) - (DATA.y_size/2.0);
+            double y = (arena_current.iy_input(iy)*(DATA.delta_y)
+                        - (DATA.y_size/2.0));
 
             // judge intersection
             if (arena_current(ix,iy,ieta).epsilon > epsFO) continue;
@@ -859,7 +1239,9 @@ void Evolve::FreezeOut_equal_tau_Surface_XY(double tau, int ieta,
 
             // get other thermodynamical quantities
             double e_local   = arena_current(ix, iy, ieta).epsilon;
-            double T_local   = eos.get_temperature(e_local, rhob_center);
+            const EOSThermo thermo = eos.get_thermo(e_local, rhob_center,
+                                                    false);
+            double T_local   = thermo.T;
             if (T_local < 0) {
                 music_message << "Evolve::FreezeOut_equal_tau_Surface: "
                               << "T_local = " << T_local
@@ -867,11 +1249,11 @@ void Evolve::FreezeOut_equal_tau_Surface_XY(double tau, int ieta,
                 music_message.flush("error");
                 exit(1);
             }
-            double muB_local = eos.get_muB(e_local, rhob_center);
-            double muS_local = eos.get_muS(e_local, rhob_center);
-            double muC_local = eos.get_muC(e_local, rhob_center);
+            double muB_local = thermo.muB;
+            double muS_local = thermo.muS;
+            double muC_local = thermo.muC;
 
-            double pressure = eos.get_pressure(e_local, rhob_center);
+            double pressure = thermo.pressure;
             double eps_plus_p_over_T = (e_local + pressure)/T_local;
 
             // finally output results
@@ -965,8 +1347,10 @@ void Evolve::FreezeOut_equal_tau_Surface_XY(double tau, int ieta,
 }
 
 
-int Evolve::FindFreezeOutSurface_boostinvariant_Cornelius(
-                double tau, SCGrid &arena_current, SCGrid &arena_freezeout) {
+template <class Cell>
+int EvolveT<Cell>::FindFreezeOutSurface_boostinvariant_Cornelius(
+                double tau, Grid &arena_current, Grid &arena_freezeout,
+                const GridBox &box) {
     const bool surface_in_binary = DATA.freeze_surface_in_binary;
 
     // find boost-invariant hyper-surfaces
@@ -1002,7 +1386,7 @@ int Evolve::FindFreezeOutSurface_boostinvariant_Cornelius(
         const double DX   = fac_x*DATA.delta_x;
         const double DY   = fac_y*DATA.delta_y;
         const double DETA = 1.0;
-        const double DTAU = facTau*DATA.delta_tau;
+        const double DTAU = freezeout_dtau;
 
         double lattice_spacing[3] = {DTAU, DX, DY};
         double x_fraction[2][3];
@@ -1026,10 +1410,16 @@ int Evolve::FindFreezeOutSurface_boostinvariant_Cornelius(
             }
         }
 
-        for (int ix=0; ix < nx - fac_x; ix += fac_x) {
-            double x = ix*(DATA.delta_x) - (DATA.x_size/2.0);
-            for (int iy=0; iy < ny - fac_y; iy += fac_y) {
-                double y = iy*(DATA.delta_y) - (DATA.y_size/2.0);
+        const int ix_start = (std::max(0, box.lo[0] - fac_x)/fac_x)*fac_x;
+        const int iy_start = (std::max(0, box.lo[1] - fac_y)/fac_y)*fac_y;
+        const int ix_end   = std::min(nx - fac_x, box.hi[0]);
+        const int iy_end   = std::min(ny - fac_y, box.hi[1]);
+        for (int ix = ix_start; ix < ix_end; ix += fac_x) {
+            double x = (arena_current.ix_input(ix)*(DATA.delta_x)
+                        - (DATA.x_size/2.0));
+            for (int iy = iy_start; iy < iy_end; iy += fac_y) {
+                double y = (arena_current.iy_input(iy)*(DATA.delta_y)
+                            - (DATA.y_size/2.0));
 
                 // judge intersection (from Bjoern)
                 intersect=1;
@@ -1158,10 +1548,12 @@ int Evolve::FindFreezeOutSurface_boostinvariant_Cornelius(
                     fluid_center.Wmunu[9] = Wmunu_regulated[3][3];
 
                     // 3-dimension interpolation done
-                    double TFO = eos.get_temperature(epsFO, fluid_center.rhob);
-                    double muB = eos.get_muB(epsFO, fluid_center.rhob);
-                    double muS = eos.get_muS(epsFO, fluid_center.rhob);
-                    double muC = eos.get_muC(epsFO, fluid_center.rhob);
+                    const EOSThermo thermo = eos.get_thermo(
+                                        epsFO, fluid_center.rhob, false);
+                    double TFO = thermo.T;
+                    double muB = thermo.muB;
+                    double muS = thermo.muS;
+                    double muC = thermo.muC;
                     if (TFO < 0) {
                         music_message << "TFO=" << TFO
                                       << "<0. ERROR. exiting.";
@@ -1169,7 +1561,7 @@ int Evolve::FindFreezeOutSurface_boostinvariant_Cornelius(
                         exit(1);
                     }
 
-                    double pressure = eos.get_pressure(epsFO, fluid_center.rhob);
+                    double pressure = thermo.pressure;
                     double eps_plus_p_over_T_FO = (epsFO + pressure)/TFO;
 
                     // finally output results !!!!
@@ -1257,16 +1649,18 @@ int Evolve::FindFreezeOutSurface_boostinvariant_Cornelius(
     return(all_frozen_flag);
 }
 
-void Evolve::regulate_qmu(const FlowVec u, const double q[],
-                          double q_regulated[]) const {
+template <class Cell>
+void EvolveT<Cell>::regulate_qmu(const FlowVec u, const double q[],
+                                 double q_regulated[]) const {
     double u_dot_q = - u[0]*q[0] + u[1]*q[1] + u[2]*q[2] + u[3]*q[3];
     for (int i = 0; i < 4; i++) {
         q_regulated[i] = q[i] + u[i]*u_dot_q;
     }
 }
 
-void Evolve::regulate_Wmunu(const FlowVec u, const double Wmunu[4][4],
-                            double Wmunu_regulated[4][4]) const {
+template <class Cell>
+void EvolveT<Cell>::regulate_Wmunu(const FlowVec u, const double Wmunu[4][4],
+                                   double Wmunu_regulated[4][4]) const {
     const double gmunu[4][4] = {{-1, 0, 0, 0},
                                 { 0, 1, 0, 0},
                                 { 0, 0, 1, 0},
@@ -1295,7 +1689,8 @@ void Evolve::regulate_Wmunu(const FlowVec u, const double Wmunu[4][4],
     }
 }
 
-void Evolve::initialize_freezeout_surface_info() {
+template <class Cell>
+void EvolveT<Cell>::initialize_freezeout_surface_info() {
     if (DATA.useEpsFO == 0) {
         const double e_freeze = eos.get_T2e(DATA.TFO, 0.0)*Util::hbarc;
         n_freeze_surf = 1;
@@ -1358,10 +1753,37 @@ void Evolve::initialize_freezeout_surface_info() {
         music_message.flush("error");
         exit(1);
     }
+
+    // the freeze-out temperature and the list file are only converted to
+    // energy densities here, so check_parameters can not test them
+    if (epsFO_list.empty()) return;
+    const double epsFO_min = *std::min_element(epsFO_list.begin(),
+                                               epsFO_list.end());
+    if (DATA.active_region_eps_cut > 0.
+            && DATA.active_region_eps_cut >= epsFO_min) {
+        music_message << "Evolve::initialize_freezeout_surface_info: "
+                      << "active_region_eps_cut = "
+                      << DATA.active_region_eps_cut
+                      << " GeV/fm^3 is not below the lowest freeze-out "
+                      << "energy density " << epsFO_min << " GeV/fm^3";
+        music_message.flush("error");
+        exit(1);
+    }
+    if (DATA.expanding_grid == 1
+            && DATA.expanding_grid_eps_cut >= epsFO_min) {
+        music_message << "Evolve::initialize_freezeout_surface_info: "
+                      << "expanding_grid_eps_cut = "
+                      << DATA.expanding_grid_eps_cut
+                      << " GeV/fm^3 is not below the lowest freeze-out "
+                      << "energy density " << epsFO_min << " GeV/fm^3";
+        music_message.flush("error");
+        exit(1);
+    }
 }
 
 
-Cell_small Evolve::three_dimension_linear_interpolation(
+template <class Cell>
+Cell_small EvolveT<Cell>::three_dimension_linear_interpolation(
         double* lattice_spacing, double fraction[2][3], Cell_small*** cube) {
     double denorm = 1.0;
     for (int i = 0; i < 3; i++) {
@@ -1382,7 +1804,8 @@ Cell_small Evolve::three_dimension_linear_interpolation(
 }
 
 
-Cell_small Evolve::four_dimension_linear_interpolation(
+template <class Cell>
+Cell_small EvolveT<Cell>::four_dimension_linear_interpolation(
         double* lattice_spacing, double fraction[2][4], Cell_small**** cube) {
     double denorm = 1.0;
     Cell_small results;
@@ -1405,7 +1828,8 @@ Cell_small Evolve::four_dimension_linear_interpolation(
 }
 
 
-Cell_aux Evolve::three_dimension_linear_interpolation(
+template <class Cell>
+Cell_aux EvolveT<Cell>::three_dimension_linear_interpolation(
         double* lattice_spacing, double fraction[2][3], Cell_aux*** cube) {
     double denorm = 1.0;
     for (int i = 0; i < 3; i++) {
@@ -1426,7 +1850,8 @@ Cell_aux Evolve::three_dimension_linear_interpolation(
 }
 
 
-Cell_aux Evolve::four_dimension_linear_interpolation(
+template <class Cell>
+Cell_aux EvolveT<Cell>::four_dimension_linear_interpolation(
         double* lattice_spacing, double fraction[2][4], Cell_aux**** cube) {
     double denorm = 1.0;
     Cell_aux results;
@@ -1447,3 +1872,6 @@ Cell_aux Evolve::four_dimension_linear_interpolation(
     results = results*(1./denorm);
     return (results);
 }
+
+template class EvolveT<Cell_small>;
+template class EvolveT<Cell_ideal>;
@@ -2,6 +2,7 @@
 #ifndef SRC_EVOLVE_H_
 #define SRC_EVOLVE_H_
 
+#include <array>
 #include <memory>
 #include <vector>
 #include "util.h"
@@ -11,19 +12,27 @@
 #include "grid_info.h"
 #include "eos.h"
 #include "advance.h"
+#include "eta_domain.h"
 #include "hydro_source_base.h"
 #include "pretty_ostream.h"
 #include "HydroinfoMUSIC.h"
 
 // this is a control class for the hydrodynamic evolution
-class Evolve {
+template <class Cell>
+class EvolveT {
  private:
+    typedef GridT<Cell> Grid;
+
     const EOS &eos;        // declare EOS object
-    const InitData &DATA;
+    InitData &DATA;        // delta_tau changes with adaptive_time_step
     std::shared_ptr<HydroSourceBase> hydro_source_terms_ptr;
 
-    Cell_info grid_info;
-    Advance advance;
+    //! the eta rows held and evolved by this MPI rank
+    EtaDomainT<Cell> domain;
+
+    Cell_infoT<Cell> grid_info;
+    AdvanceT<Cell> advance;
+    U_derivative_poolT<Cell> u_derivative_helpers;
     pretty_ostream music_message;
 
     // simulation information
@@ -36,36 +45,93 @@ class Evolve {
     int n_freeze_surf;
     std::vector<double> epsFO_list;
 
-    typedef std::unique_ptr<SCGrid, void(*)(SCGrid*)> GridPointer;
+    typedef std::unique_ptr<Grid, void(*)(Grid*)> GridPointer;
+
+    //! tau distance from the last freeze-out slice (arena_freezeout) to
+    //! the current step, and from arena_freezeout_prev to arena_freezeout;
+    //! facTau*delta_tau and delta_tau unless adaptive_time_step
+    double freezeout_dtau;
+    double freezeout_dtau_prev;
+
+    //! Delta_Tau of the input, the floor of the relaxation-time limit of
+    //! the adaptive time step
+    double delta_tau_initial;
+
+    //! times of the check files of the analytic test profiles
+    std::vector<double> check_file_taus;
+
+    //! derivative fields of the current step (at tau), shared by the
+    //! outputs, the freeze-out and the first RK stage, and of the last
+    //! freeze-out step (the earlier slice of the next freeze-out)
+    DerivedFieldSliceT<Cell> derived_fields;
+    DerivedFieldSliceT<Cell> freezeout_derived_fields;
+    //! derivative fields of the whole grid gathered for the outputs of an
+    //! MPI run (derived_fields on a single rank)
+    DerivedFieldSliceT<Cell> whole_grid_fields;
+    //! corners of the crossed hypercubes in prepare_freezeout_aux
+    std::vector<int> freezeout_corners;
 
  public:
-    Evolve(const EOS &eos, const InitData &DATA_in,
-           std::shared_ptr<HydroSourceBase> hydro_source_ptr_in);
-    int EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
-                 SCGrid &arena_future, HydroinfoMUSIC &hydro_info_ptr);
+    EvolveT(const EOS &eos, InitData &DATA_in,
+            std::shared_ptr<HydroSourceBase> hydro_source_ptr_in);
+    int EvolveIt(Grid &arena_prev, Grid &arena_current,
+                 Grid &arena_future, HydroinfoMUSIC &hydro_info_ptr);
 
     void AdvanceRK(double tau, GridPointer &arena_prev,
                    GridPointer &arena_current, GridPointer &arena_future);
 
-    int FreezeOut_equal_tau_Surface(double tau, SCGrid &arena_current);
+    //! time step for adaptive_time_step: the stable step of Advance,
+    //! growing by at most 20% per step and shortened so that an integer
+    //! number of steps ends on tau_stop
+    double adaptive_time_step(const double tau, const Grid &arena_current,
+                              const double tau_stop);
+    //! the first tau after tau on which the adaptive steps have to end:
+    //! the evolution output grid (if any evolution output is on), the
+    //! check-file times and tau_end
+    double next_stop_tau(const double tau, const double tau_end) const;
+    //! whether any of the evolution outputs of the output steps is on
+    bool has_evolution_output() const;
+
+    int FreezeOut_equal_tau_Surface(double tau, Grid &arena_current);
     void FreezeOut_equal_tau_Surface_XY(double tau,
-                                        int ieta, SCGrid &arena_current,
+                                        int ieta, Grid &arena_current,
                                         int thread_id, double epsFO);
+    //! the surface finders only scan the cubes touching box
     int FindFreezeOutSurface_Cornelius(double tau,
-        SCGrid &arena_prev, SCGrid &arena_current,
-        SCGrid &arena_freezeout_prev, SCGrid &arena_freezeout);
+        Grid &arena_prev, Grid &arena_current,
+        Grid &arena_freezeout_prev, Grid &arena_freezeout,
+        const GridBox &box);
+
+    //! adds the corners of all crossed hypercubes to derived_fields and
+    //! freezeout_derived_fields
+    void prepare_freezeout_aux(double tau,
+        Grid &arena_prev, Grid &arena_current,
+        Grid &arena_freezeout_prev, Grid &arena_freezeout,
+        const GridBox &box);
+    bool hypercube_crosses(const Grid &arena_current,
+                           const Grid &arena_freezeout,
+                           const int ix, const int iy, const int ieta,
+                           const int fac_x, const int fac_y,
+                           const int fac_eta, const double epsFO) const;
 
     int FindFreezeOutSurface_Cornelius_XY(double tau, int ieta,
-                                          SCGrid &arena_prev,
-                                          SCGrid &arena_current,
-                                          SCGrid &arena_freezeout_prev,
-                                          SCGrid &arena_freezeout,
+                                          Grid &arena_prev,
+                                          Grid &arena_current,
+                                          Grid &arena_freezeout_prev,
+                                          Grid &arena_freezeout,
+                                          const GridBox &box,
                                           int thread_id, double epsFO);
     int FindFreezeOutSurface_boostinvariant_Cornelius(
-                double tau, SCGrid &arena_current, SCGrid &arena_freezeout);
+                double tau, Grid &arena_current, Grid &arena_freezeout,
+                const GridBox &box);
 
-    void store_previous_step_for_freezeout(SCGrid &arena_current,
-                                           SCGrid &arena_freezeout);
+    std::array<int, 2> transverse_grid_change(const Grid &arena,
+                                              const bool initial) const;
+    void resize_transverse_grid(const int kx, const int ky,
+                                const std::vector<Grid*> &arenas);
+
+    void store_previous_step_for_freezeout(Grid &arena_current,
+                                           Grid &arena_freezeout);
     void regulate_qmu(const FlowVec u, const double q[],
                       double q_regulated[]) const;
     void regulate_Wmunu(const FlowVec u, const double Wmunu[4][4],
@@ -83,5 +149,7 @@ class Evolve {
         double* lattice_spacing, double fraction[2][3], Cell_aux*** cube);
 };
 
+typedef EvolveT<Cell_small> Evolve;
+
 #endif  // SRC_EVOLVE_H_
 
@@ -1,31 +1,113 @@
 #ifndef _SRC_GRID_H_
 #define _SRC_GRID_H_
 
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <memory>
+#include <utility>
 #include <vector>
 #include "cell.h"
 #include "grid.h"
 
+//! allocator whose argument-less construct() does nothing, so that
+//! std::vector::resize only reserves the memory. The grids construct the
+//! cells themselves in a parallel loop; each page is then first touched,
+//! and placed on the NUMA node of, the thread that later sweeps it.
+template<class T>
+struct FirstTouchAllocator : std::allocator<T> {
+    template<class U> struct rebind {typedef FirstTouchAllocator<U> other;};
+
+    FirstTouchAllocator() = default;
+    template<class U>
+    FirstTouchAllocator(const FirstTouchAllocator<U>&) {}
+
+    template<class U>
+    void construct(U*) {}
+    template<class U, class... Args>
+    void construct(U *p, Args&&... args) {
+        ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
 template<class T>
 class GridT {
  private:
-    std::vector<T> grid;
+    std::vector<T, FirstTouchAllocator<T>> grid;
 
     int Nx   = 0;
     int Ny   = 0;
     int Neta = 0;
 
+    //! width of the ghost layer in each direction (0 if not padded)
+    int Ngx   = 0;
+    int Ngy   = 0;
+    int Ngeta = 0;
+
+    //! dimensions of the allocated (padded) array
+    int NxP   = 0;
+    int NyP   = 0;
+
+    //! index of the cell (0, 0, 0) in the input grid; only nonzero for a
+    //! grid made by transverse_resized (Ox, Oy) or eta_rows (Oeta)
+    int Ox = 0;
+    int Oy = 0;
+    int Oeta = 0;
+
     T& get(int x, int y, int eta) {
-        return grid[Nx*(Ny*eta+y)+x];
+        return grid[NxP*(NyP*(eta+Ngeta)+(y+Ngy))+(x+Ngx)];
+    }
+
+    const T& get(int x, int y, int eta) const {
+        return grid[NxP*(NyP*(eta+Ngeta)+(y+Ngy))+(x+Ngx)];
+    }
+
+    static int clamp(const int i, const int N) {
+        if (i < 0) return 0;
+        if (i >= N) return N - 1;
+        return i;
     }
 
  public:
+    typedef T cell_view;
+
     GridT() = default;
-    GridT(int Nx0, int Ny0, int Neta0) {
-        Nx   = Nx0  ;
-        Ny   = Ny0  ;
-        Neta = Neta0;
-        grid.resize(Nx*Ny*Neta);
+
+    //! Nghost > 0 allocates a ghost layer of that width around the grid
+    //! in every direction with more than one cell. The ghost cells are
+    //! only valid after fill_ghost_cells() has been called.
+    GridT(int Nx0, int Ny0, int Neta0, int Nghost = 0) {
+        Nx    = Nx0  ;
+        Ny    = Ny0  ;
+        Neta  = Neta0;
+        Ngx   = Nx   > 1 ? Nghost : 0;
+        Ngy   = Ny   > 1 ? Nghost : 0;
+        Ngeta = Neta > 1 ? Nghost : 0;
+        NxP   = Nx + 2*Ngx;
+        NyP   = Ny + 2*Ngy;
+        grid.resize(NxP*NyP*(Neta + 2*Ngeta));
+        // first touch: contiguous static chunks, the same split of the
+        // (eta, y) rows that Brickloop hands to the threads
+        const int ncells = grid.size();
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < ncells; i++) {
+            ::new(static_cast<void*>(&grid[i])) T();
+        }
+    }
+
+    //! copy of a grid with another cell type (e.g. SCGrid -> IdealGrid)
+    //! with the same dimensions and ghost width
+    template <class U>
+    explicit GridT(const GridT<U> &other)
+        : GridT(other.nX(), other.nY(), other.nEta(), other.nGhost()) {
+        Ox = other.ix_input(0);
+        Oy = other.iy_input(0);
+        Oeta = other.ieta_input(0);
+        for (int i = 0; i < size(); i++)
+            (*this)(i) = T(other(i));
     }
 
     int nX()   const {return(Nx );  }
@@ -33,6 +115,93 @@ class GridT {
     int nEta() const {return(Neta );}
     int size() const {return Nx*Ny*Neta;}
 
+    //! index in the input grid (the one DATA.nx, DATA.x_size, ... describe)
+    //! of the cell ix (iy); x = ix_input(ix)*delta_x - x_size/2
+    int ix_input(const int ix) const {return(ix + Ox);}
+    int iy_input(const int iy) const {return(iy + Oy);}
+    int ieta_input(const int ieta) const {return(ieta + Oeta);}
+
+    //! width of the ghost layer (0 for an unpadded grid)
+    int nGhost() const {return std::max(Ngx, std::max(Ngy, Ngeta));}
+
+    //! distance in memory between neighbouring cells along direction
+    //! dir (1: x, 2: y, 3: eta); 0 along a single-cell direction
+    int stride(const int dir) const {
+        if (dir == 1) return(Nx   > 1 ? 1       : 0);
+        if (dir == 2) return(Ny   > 1 ? NxP     : 0);
+        return(Neta > 1 ? NxP*NyP : 0);
+    }
+
+    //! the eta_row_size() contiguous cells (including the x and y ghost
+    //! cells) of the eta row eta, -Ngeta <= eta < Neta + Ngeta;
+    //! consecutive rows follow each other in memory
+    T* eta_row(const int eta) {return(&grid[NxP*NyP*(eta + Ngeta)]);}
+    int eta_row_size() const {return(NxP*NyP);}
+
+    //! copies the nearest interior cell into every ghost cell
+    //! (outflow boundary condition, identical to the clamping in getHalo)
+    void fill_ghost_cells() {
+        fill_ghost_cells(-Ngeta, Neta + Ngeta);
+    }
+
+    //! fill_ghost_cells() restricted to the ghost cells in the eta rows
+    //! eta_begin <= eta < eta_end (clipped to the padded grid)
+    void fill_ghost_cells(const int eta_begin, const int eta_end) {
+        if (nGhost() == 0) return;
+        const int eta_lo = std::max(eta_begin, -Ngeta);
+        const int eta_hi = std::min(eta_end, Neta + Ngeta);
+        #pragma omp parallel for collapse(2)
+        for (int eta = eta_lo; eta < eta_hi; eta++)
+        for (int y   = -Ngy;   y   < Ny   + Ngy;   y++  ) {
+            const int ceta = clamp(eta, Neta);
+            const int cy   = clamp(y,   Ny  );
+            if (ceta == eta && cy == y) {
+                for (int x = 1; x <= Ngx; x++) {
+                    get(-x,         y, eta) = get(0,      y, eta);
+                    get(Nx - 1 + x, y, eta) = get(Nx - 1, y, eta);
+                }
+            } else {
+                for (int x = -Ngx; x < Nx + Ngx; x++)
+                    get(x, y, eta) = get(clamp(x, Nx), cy, ceta);
+            }
+        }
+    }
+
+    //! copy of the grid with kx (ky) cells added on both sides in x (y);
+    //! negative values crop the grid. Added cells copy the nearest cell of
+    //! the old grid (outflow boundary condition).
+    GridT transverse_resized(const int kx, const int ky) const {
+        GridT res(Nx + 2*kx, Ny + 2*ky, Neta, nGhost());
+        res.Ox = Ox - kx;
+        res.Oy = Oy - ky;
+        res.Oeta = Oeta;
+        #pragma omp parallel for collapse(2)
+        for (int eta = 0; eta < res.Neta; eta++)
+        for (int y   = 0; y   < res.Ny;   y++  )
+        for (int x   = 0; x   < res.Nx;   x++  ) {
+            res.get(x, y, eta) = get(clamp(x - kx, Nx), clamp(y - ky, Ny),
+                                     eta);
+        }
+        return(res);
+    }
+
+    //! copy of the eta rows eta_begin <= eta < eta_end of the grid (one
+    //! slab of an MPI run); rows outside of the grid copy the nearest row
+    //! (outflow boundary condition)
+    GridT eta_rows(const int eta_begin, const int eta_end) const {
+        GridT res(Nx, Ny, eta_end - eta_begin, nGhost());
+        res.Ox   = Ox;
+        res.Oy   = Oy;
+        res.Oeta = Oeta + eta_begin;
+        #pragma omp parallel for collapse(2)
+        for (int eta = 0; eta < res.Neta; eta++)
+        for (int y   = 0; y   < res.Ny;   y++  )
+        for (int x   = 0; x   < res.Nx;   x++  ) {
+            res.get(x, y, eta) = get(x, y, clamp(eta + eta_begin, Neta));
+        }
+        return(res);
+    }
+
     T& getHalo(int x, int y, int eta){
         assert(-2<=x  ); assert(x  <Nx  +2);
         assert(-2<=y  ); assert(y  <Ny  +2);
@@ -44,7 +213,13 @@ class GridT {
     }
 
     const T& getHalo(int x, int y, int eta) const {
-        return getHalo(x, y, eta);
+        assert(-2<=x  ); assert(x  <Nx  +2);
+        assert(-2<=y  ); assert(y  <Ny  +2);
+        assert(-2<=eta); assert(eta<Neta+2);
+        if(x  <0)   x  =0;  else if(x  >=Nx)   x  = Nx   - 1;
+        if(y  <0)   y  =0;  else if(y  >=Ny)   y  = Ny   - 1;
+        if(eta<0)   eta=0;  else if(eta>=Neta) eta= Neta - 1;
+        return get(x,y,eta);
     }
 
     T& operator()(const int x, const int y, const int eta) {
@@ -63,12 +238,14 @@ class GridT {
 
     T& operator()(const int i) {
         assert(0<=i  ); assert(i<Nx*Ny*Neta);
-        return grid[i];
+        if (nGhost() == 0) return grid[i];
+        return get(i%Nx, (i/Nx)%Ny, i/(Nx*Ny));
     }
 
     const T& operator()(const int i) const {
         assert(0<=i  ); assert(i<Nx*Ny*Neta);
-        return grid[i];
+        if (nGhost() == 0) return grid[i];
+        return get(i%Nx, (i/Nx)%Ny, i/(Nx*Ny));
     }
 
     void clear() {
@@ -78,13 +255,160 @@ class GridT {
 };
 
 typedef GridT<Cell_small> SCGrid;
+typedef GridT<Cell_ideal> IdealGrid;
+
+
+//! Read-only view on one cell of an SCGridSoA. It exposes the member
+//! surface of Cell_small (c.epsilon, c.rhob, c.u[mu], c.Wmunu[i], c.pi_b),
+//! so the stencil kernels can be written once for both storage layouts.
+class CellSoAView {
+ public:
+    class Component {
+     private:
+        const double *ptr;
+        const int stride;
+
+     public:
+        Component(const double *ptr_in, const int stride_in) :
+            ptr(ptr_in), stride(stride_in) {}
+        double operator[](const int i) const {return ptr[i*stride];}
+    };
+
+    const double &epsilon;
+    const double &rhob;
+    const Component u;
+    const Component Wmunu;
+    const double &pi_b;
+
+    CellSoAView(const double &e_in, const double &rhob_in,
+                const Component u_in, const Component Wmunu_in,
+                const double &pi_b_in) :
+        epsilon(e_in), rhob(rhob_in), u(u_in), Wmunu(Wmunu_in),
+        pi_b(pi_b_in) {}
+};
+
+
+//! Structure-of-arrays mirror of an SCGrid. Every field of Cell_small is
+//! stored in its own contiguous plane, so a stencil that only reads
+//! epsilon, rhob and u does not drag the viscous tensors through the cache.
+class SCGridSoA {
+ private:
+    enum {EPS = 0, RHOB = 1, U = 2, WMUNU = 6, PI_B = 20, NFIELDS = 21};
+
+    std::vector<double, FirstTouchAllocator<double>> data;
+
+    int Nx   = 0;
+    int Ny   = 0;
+    int Neta = 0;
+    int Ncells = 0;
+
+    CellSoAView get(int x, int y, int eta) const {
+        const double *p = &data[Nx*(Ny*eta+y)+x];
+        return CellSoAView(p[EPS*Ncells], p[RHOB*Ncells],
+                           CellSoAView::Component(p + U*Ncells, Ncells),
+                           CellSoAView::Component(p + WMUNU*Ncells, Ncells),
+                           p[PI_B*Ncells]);
+    }
+
+ public:
+    typedef CellSoAView cell_view;
+
+    SCGridSoA() = default;
+    SCGridSoA(int Nx0, int Ny0, int Neta0) {
+        Nx     = Nx0  ;
+        Ny     = Ny0  ;
+        Neta   = Neta0;
+        Ncells = Nx*Ny*Neta;
+        data.resize(NFIELDS*Ncells);
+        // first touch with the partitioning of copy_from
+        for (int field = 0; field < NFIELDS; field++) {
+            double *plane = &data[field*Ncells];
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < Ncells; i++) {
+                plane[i] = 0.;
+            }
+        }
+    }
+
+    int nX()   const {return(Nx );  }
+    int nY()   const {return(Ny );  }
+    int nEta() const {return(Neta );}
+    int size() const {return Ncells;}
+
+    //! transpose an SCGrid of the same dimension into this grid
+    template <class CellType>
+    void copy_from(const GridT<CellType> &arena) {
+        copy_from(arena, 0, Neta);
+    }
+
+    //! copy_from() restricted to the eta rows eta_begin <= eta < eta_end
+    template <class CellType>
+    void copy_from(const GridT<CellType> &arena, const int eta_begin,
+                   const int eta_end) {
+        assert(arena.nX() == Nx && arena.nY() == Ny && arena.nEta() == Neta);
+        const int i_begin = Nx*Ny*std::max(eta_begin, 0);
+        const int i_end   = Nx*Ny*std::min(eta_end, Neta);
+        double *eps  = &data[EPS*Ncells];
+        double *rhob = &data[RHOB*Ncells];
+        double *u    = &data[U*Ncells];
+        double *W    = &data[WMUNU*Ncells];
+        double *pi_b = &data[PI_B*Ncells];
+        #pragma omp parallel for schedule(static)
+        for (int i = i_begin; i < i_end; i++) {
+            const CellType &cell = arena(i);
+            eps [i] = cell.epsilon;
+            rhob[i] = cell.rhob;
+            for (int mu = 0; mu < 4; mu++)
+                u[mu*Ncells + i] = cell.u[mu];
+            for (int j = 0; j < 14; j++)
+                W[j*Ncells + i] = cell.Wmunu[j];
+            pi_b[i] = cell.pi_b;
+        }
+    }
+
+    CellSoAView getHalo(int x, int y, int eta) const {
+        assert(-2<=x  ); assert(x  <Nx  +2);
+        assert(-2<=y  ); assert(y  <Ny  +2);
+        assert(-2<=eta); assert(eta<Neta+2);
+        if(x  <0)   x  =0;  else if(x  >=Nx)   x  = Nx   - 1;
+        if(y  <0)   y  =0;  else if(y  >=Ny)   y  = Ny   - 1;
+        if(eta<0)   eta=0;  else if(eta>=Neta) eta= Neta - 1;
+        return get(x,y,eta);
+    }
 
+    CellSoAView operator()(int x, int y, int eta) const {
+        assert(0<=x  ); assert(x  <Nx);
+        assert(0<=y  ); assert(y  <Ny);
+        assert(0<=eta); assert(eta<Neta);
+        return get(x, y, eta);
+    }
+
+    void clear() {
+        data.clear();
+        data.shrink_to_fit();
+        Nx = Ny = Neta = Ncells = 0;
+    }
+};
+
+//! calls func(c, p1, p2, m1, m2, direction) with the cell (cx, cy, ceta)
+//! and its neighbours at +-1, +-2 along the first n_direc directions
+//! (2 skips eta, e.g. on a boost-invariant grid)
 template<class T, class Func>
-void Neighbourloop(GridT<T> &arena, int cx, int cy, int ceta, Func func) {
+void Neighbourloop(GridT<T> &arena, int cx, int cy, int ceta, Func func,
+                   const int n_direc = 3) {
+    if (arena.nGhost() >= 2) {
+        // padded grid: the +-2 neighbours are plain offsets in memory
+        T* c = &arena(cx, cy, ceta);
+        for(int dir = 1; dir <= n_direc; dir++) {
+            const int s = arena.stride(dir);
+            func(*c, c[s], c[2*s], c[-s], c[-2*s], dir);
+        }
+        return;
+    }
     const std::array<int, 6> dx   = {-1, 1,  0, 0,  0, 0};
     const std::array<int, 6> dy   = { 0, 0, -1, 1,  0, 0};
     const std::array<int, 6> deta = { 0, 0,  0, 0, -1, 1};
-    for(int dir = 0; dir < 3; dir++) {
+    for(int dir = 0; dir < n_direc; dir++) {
         const int m1nx   = dx  [2*dir];
         const int m1ny   = dy  [2*dir];
         const int m1neta = deta[2*dir];
@@ -106,6 +430,189 @@ void Neighbourloop(GridT<T> &arena, int cx, int cy, int ceta, Func func) {
     }
 }
 
+//! read-only variant for grids whose cells are views (e.g. SCGridSoA)
+template<class Grid, class Func>
+void Neighbourloop(const Grid &arena, int cx, int cy, int ceta, Func func,
+                   const int n_direc = 3) {
+    const std::array<int, 6> dx   = {-1, 1,  0, 0,  0, 0};
+    const std::array<int, 6> dy   = { 0, 0, -1, 1,  0, 0};
+    const std::array<int, 6> deta = { 0, 0,  0, 0, -1, 1};
+    for(int dir = 0; dir < n_direc; dir++) {
+        const int m1nx   = dx  [2*dir];
+        const int m1ny   = dy  [2*dir];
+        const int m1neta = deta[2*dir];
+        const int p1nx   = dx  [2*dir+1];
+        const int p1ny   = dy  [2*dir+1];
+        const int p1neta = deta[2*dir+1];
+        const auto& c    = arena        (cx,        cy,        ceta         );
+        const auto& p1   = arena.getHalo(cx+p1nx,   cy+p1ny,   ceta+p1neta  );
+        const auto& p2   = arena.getHalo(cx+2*p1nx, cy+2*p1ny, ceta+2*p1neta);
+        const auto& m1   = arena.getHalo(cx+m1nx,   cy+m1ny,   ceta+m1neta  );
+        const auto& m2   = arena.getHalo(cx+2*m1nx, cy+2*m1ny, ceta+2*m1neta);
+        func(c,p1,p2,m1,m2,dir+1);
+    }
+}
+
+//! box [lo, hi) of cell indices along x, y and eta
+struct GridBox {
+    std::array<int, 3> lo = {{0, 0, 0}};
+    std::array<int, 3> hi = {{0, 0, 0}};
+
+    GridBox() = default;
+    //! the whole nx*ny*neta grid
+    GridBox(const int nx, const int ny, const int neta)
+        : hi{{nx, ny, neta}} {}
+
+    int size() const {
+        return(std::max(0, hi[0] - lo[0])*std::max(0, hi[1] - lo[1])
+               *std::max(0, hi[2] - lo[2]));
+    }
+
+    bool contains(const int ix, const int iy, const int ieta) const {
+        return(   ix   >= lo[0] && ix   < hi[0]
+               && iy   >= lo[1] && iy   < hi[1]
+               && ieta >= lo[2] && ieta < hi[2]);
+    }
+
+    //! grows the box to the bounding box of itself and other
+    void extend(const GridBox &other) {
+        if (other.size() == 0) return;
+        if (size() == 0) {
+            *this = other;
+            return;
+        }
+        for (int i = 0; i < 3; i++) {
+            lo[i] = std::min(lo[i], other.lo[i]);
+            hi[i] = std::max(hi[i], other.hi[i]);
+        }
+    }
+};
+
+//! bounding box of the cells with epsilon > eps_cut, widened by margin
+//! cells on every side and clipped to the grid (empty if no cell is
+//! above eps_cut)
+template<class GridType>
+GridBox find_active_box(const GridType &arena, const double eps_cut,
+                        const int margin) {
+    const int nx   = arena.nX();
+    const int ny   = arena.nY();
+    const int neta = arena.nEta();
+    int x_lo = nx, y_lo = ny, eta_lo = neta;
+    int x_hi = -1, y_hi = -1, eta_hi = -1;
+    #pragma omp parallel for collapse(2) reduction(min:x_lo, y_lo, eta_lo) \
+                                         reduction(max:x_hi, y_hi, eta_hi)
+    for (int ieta = 0; ieta < neta; ieta++)
+    for (int iy   = 0; iy   < ny;   iy++  )
+    for (int ix   = 0; ix   < nx;   ix++  ) {
+        if (arena(ix, iy, ieta).epsilon > eps_cut) {
+            x_lo   = std::min(x_lo,   ix  ); x_hi   = std::max(x_hi,   ix  );
+            y_lo   = std::min(y_lo,   iy  ); y_hi   = std::max(y_hi,   iy  );
+            eta_lo = std::min(eta_lo, ieta); eta_hi = std::max(eta_hi, ieta);
+        }
+    }
+    GridBox box;
+    if (x_hi < 0) return(box);
+    box.lo = {{std::max(0, x_lo - margin), std::max(0, y_lo - margin),
+               std::max(0, eta_lo - margin)}};
+    box.hi = {{std::min(nx,   x_hi   + 1 + margin),
+               std::min(ny,   y_hi   + 1 + margin),
+               std::min(neta, eta_hi + 1 + margin)}};
+    return(box);
+}
+
+//! the brick shape Pencilloop uses for box: brick (a size <= 0 spans the
+//! whole box in that direction), halved in y, then in x (not below 16
+//! cells) and then in eta until there are at least 4 bricks per thread.
+//! A 2+1D grid would otherwise only give about ny/brick[1] work items.
+inline std::array<int, 3> brick_shape(const GridBox &box,
+                                      const std::array<int, 3> &brick,
+                                      const int n_threads) {
+    std::array<int, 3> b;
+    for (int i = 0; i < 3; i++) {
+        const int n = box.hi[i] - box.lo[i];
+        b[i] = (brick[i] > 0) ? std::min(brick[i], n) : n;
+        b[i] = std::max(b[i], 1);
+    }
+    auto n_bricks = [&box, &b]() {
+        long n = 1;
+        for (int i = 0; i < 3; i++) {
+            n *= (box.hi[i] - box.lo[i] + b[i] - 1)/b[i];
+        }
+        return(n);
+    };
+    const long min_bricks = 4L*n_threads;
+    const int min_size[3] = {16, 1, 1};
+    const int order[3] = {1, 0, 2};
+    for (const int i : order) {
+        while (n_bricks() < min_bricks && b[i]/2 >= min_size[i]) {
+            b[i] = (b[i] + 1)/2;
+        }
+    }
+    return(b);
+}
+
+//! calls func(ix_begin, ix_end, iy, ieta) for every x-row segment
+//! [ix_begin, ix_end) of box. The box is cut into bricks of the shape
+//! brick_shape(box, brick, n_threads) which are distributed over the
+//! OpenMP threads in contiguous static chunks (matching the first touch in
+//! GridT); inside a brick the rows follow the storage order of GridT.
+template<class Func>
+void Pencilloop(const GridBox &box, const std::array<int, 3> &brick,
+                Func func) {
+    if (box.size() == 0) return;
+#ifdef _OPENMP
+    const int n_threads = omp_get_max_threads();
+#else
+    const int n_threads = 1;
+#endif
+    const auto b = brick_shape(box, brick, n_threads);
+    const int nx   = box.hi[0] - box.lo[0];
+    const int ny   = box.hi[1] - box.lo[1];
+    const int neta = box.hi[2] - box.lo[2];
+    const int bx   = b[0];
+    const int by   = b[1];
+    const int beta = b[2];
+    const int nbx   = (nx   + bx   - 1)/bx;
+    const int nby   = (ny   + by   - 1)/by;
+    const int nbeta = (neta + beta - 1)/beta;
+    #pragma omp parallel for collapse(3) schedule(static)
+    for (int ib_eta = 0; ib_eta < nbeta; ib_eta++)
+    for (int ib_y   = 0; ib_y   < nby;   ib_y++  )
+    for (int ib_x   = 0; ib_x   < nbx;   ib_x++  ) {
+        const int eta_0 = box.lo[2] + ib_eta*beta;
+        const int y_0   = box.lo[1] + ib_y*by;
+        const int x_0   = box.lo[0] + ib_x*bx;
+        const int eta_end = std::min(eta_0 + beta, box.hi[2]);
+        const int y_end   = std::min(y_0   + by,   box.hi[1]);
+        const int x_end   = std::min(x_0   + bx,   box.hi[0]);
+        for (int ieta = eta_0; ieta < eta_end; ieta++)
+        for (int iy   = y_0;   iy   < y_end;   iy++  ) {
+            func(x_0, x_end, iy, ieta);
+        }
+    }
+}
+
+//! calls func(ix, iy, ieta) for every cell of box, brick by brick as in
+//! Pencilloop, with ix running fastest
+template<class Func>
+void Brickloop(const GridBox &box, const std::array<int, 3> &brick,
+               Func func) {
+    Pencilloop(box, brick, [&](const int ix_begin, const int ix_end,
+                               const int iy, const int ieta) {
+        for (int ix = ix_begin; ix < ix_end; ix++) {
+            func(ix, iy, ieta);
+        }
+    });
+}
+
+//! Brickloop over every cell of an nx*ny*neta grid
+template<class Func>
+void Brickloop(const int nx, const int ny, const int neta,
+               const std::array<int, 3> &brick, Func func) {
+    Brickloop(GridBox(nx, ny, neta), brick, func);
+}
+
 #define NLAMBDAS [&](Cell_small& c, const Cell_small& p1, const Cell_small& p2, const Cell_small& m1, const Cell_small& m2, const int direction) 
+#define NLAMBDAS_VIEW(CellT) [&](const CellT& c, const CellT& p1, const CellT& p2, const CellT& m1, const CellT& m2, const int direction) 
 
 #endif
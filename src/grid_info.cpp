@@ -3,6 +3,8 @@
 #include <iomanip>
 #include <cmath>
 #include <vector>
+#include <array>
+#include <algorithm>
 
 #include "util.h"
 #include "grid_info.h"
@@ -17,10 +19,12 @@ using std::endl;
 using std::ofstream;
 using std::ostringstream;
 
-Cell_info::Cell_info(const InitData &DATA_in, const EOS &eos_in) :
+template <class Cell>
+Cell_infoT<Cell>::Cell_infoT(const InitData &DATA_in, const EOS &eos_in,
+                             const EtaDomainT<Cell> &domain_in) :
     DATA(DATA_in),
     eos(eos_in),
-    u_derivative_helper(DATA_in, eos_in) {
+    domain(domain_in) {
 
     // read in tables for delta f coefficients
     if (DATA.turn_on_diff == 1) {
@@ -37,7 +41,8 @@ Cell_info::Cell_info(const InitData &DATA_in, const EOS &eos_in) :
     outflow_flux = {0.};
 }
 
-Cell_info::~Cell_info() {
+template <class Cell>
+Cell_infoT<Cell>::~Cell_infoT() {
     if (DATA.turn_on_diff == 1) {
         if (DATA.deltaf_14moments == 1) {
             for (int i = 0; i < deltaf_coeff_table_14mom_length_T; i++) {
@@ -66,7 +71,8 @@ Cell_info::~Cell_info() {
 
 
 //! This function outputs a header files for JF and Gojko's EM program
-void Cell_info::Output_hydro_information_header() {
+template <class Cell>
+void Cell_infoT<Cell>::Output_hydro_information_header() {
     string fname = "hydro_info_header_h";
 
     // Open output file
@@ -94,7 +100,7 @@ void Cell_info::Output_hydro_information_header() {
             << DATA.delta_eta*DATA.output_evolution_every_N_eta << ";"
             << endl;
     outfile << "const double MUSIC_dtau = "
-            << DATA.output_evolution_every_N_timesteps*DATA.delta_tau << ";"
+            << DATA.delta_tau_output << ";"
             << endl;
 
     outfile << "const bool MUSIC_with_shear_viscosity = "
@@ -113,7 +119,8 @@ void Cell_info::Output_hydro_information_header() {
 
 
 //! This function outputs hydro evolution file in binary format
-void Cell_info::OutputEvolutionDataXYEta(SCGrid &arena, double tau) {
+template <class Cell>
+void Cell_infoT<Cell>::OutputEvolutionDataXYEta(Grid &arena, double tau) {
     const string out_name_xyeta = "evolution_xyeta.dat";
     const string out_name_W_xyeta =
                         "evolution_Wmunu_over_epsilon_plus_P_xyeta.dat";
@@ -163,7 +170,8 @@ void Cell_info::OutputEvolutionDataXYEta(SCGrid &arena, double tau) {
             for (int ix = 0; ix < arena.nX(); ix += n_skip_x) {
                 double e_local    = arena(ix, iy, ieta).epsilon;  // 1/fm^4
                 double rhob_local = arena(ix, iy, ieta).rhob;     // 1/fm^3
-                double p_local = eos.get_pressure(e_local, rhob_local);
+                const EOSThermo thermo = eos.get_thermo(e_local, rhob_local);
+                double p_local = thermo.pressure;
                 double utau = arena(ix, iy, ieta).u[0];
                 double ux   = arena(ix, iy, ieta).u[1];
                 double uy   = arena(ix, iy, ieta).u[2];
@@ -174,9 +182,9 @@ void Cell_info::OutputEvolutionDataXYEta(SCGrid &arena, double tau) {
                 double uz = ueta*cosh_eta + utau*sinh_eta;
                 double vz = uz/ut;
 
-                double T_local   = eos.get_temperature(e_local, rhob_local);
-                double cs2_local = eos.get_cs2(e_local, rhob_local);
-                double muB_local = eos.get_muB(e_local, rhob_local);
+                double T_local   = thermo.T;
+                double cs2_local = thermo.cs2;
+                double muB_local = thermo.muB;
                 double enthropy  = e_local + p_local;  // [1/fm^4]
 
                 double Wtautau = 0.0;
@@ -294,8 +302,9 @@ void Cell_info::OutputEvolutionDataXYEta(SCGrid &arena, double tau) {
 }
 
 
-void Cell_info::OutputEvolution_Knudsen_Reynoldsnumbers(
-        SCGrid &arena, const double tau) const {
+template <class Cell>
+void Cell_infoT<Cell>::OutputEvolution_Knudsen_Reynoldsnumbers(
+        Grid &arena, const double tau) const {
     const string out_name_xyeta = "evolution_KRnumbers.dat";
     FILE *out_file_xyeta        = NULL;
 
@@ -338,8 +347,9 @@ void Cell_info::OutputEvolution_Knudsen_Reynoldsnumbers(
 }
 
 
-void Cell_info::calculate_inverse_Reynolds_numbers(
-                                SCGrid &arena_current,
+template <class Cell>
+void Cell_infoT<Cell>::calculate_inverse_Reynolds_numbers(
+                                Grid &arena_current,
                                 const int ieta, const int ix, const int iy,
                                 double &R_pi, double &R_Pi) const {
     const auto grid_pt = arena_current(ix, iy, ieta);
@@ -372,8 +382,9 @@ void Cell_info::calculate_inverse_Reynolds_numbers(
 
 
 //! This function outputs hydro evolution file into memory for JETSCAPE
-void Cell_info::OutputEvolutionDataXYEta_memory(
-            SCGrid &arena, const double tau, HydroinfoMUSIC &hydro_info_ptr) {
+template <class Cell>
+void Cell_infoT<Cell>::OutputEvolutionDataXYEta_memory(
+            Grid &arena, const double tau, HydroinfoMUSIC &hydro_info_ptr) {
     const int n_skip_x   = DATA.output_evolution_every_N_x;
     const int n_skip_y   = DATA.output_evolution_every_N_y;
     const int n_skip_eta = DATA.output_evolution_every_N_eta;
@@ -390,7 +401,9 @@ void Cell_info::OutputEvolutionDataXYEta_memory(
 
                 double e_local    = arena(ix, iy, ieta).epsilon;  // 1/fm^4
                 double rhob_local = arena(ix, iy, ieta).rhob;     // 1/fm^3
-                double p_local = eos.get_pressure(e_local, rhob_local);
+                const EOSThermo thermo = eos.get_thermo(e_local, rhob_local,
+                                                        false);
+                double p_local = thermo.pressure;
                 double utau = arena(ix, iy, ieta).u[0];
                 double ux   = arena(ix, iy, ieta).u[1];
                 double uy   = arena(ix, iy, ieta).u[2];
@@ -401,8 +414,8 @@ void Cell_info::OutputEvolutionDataXYEta_memory(
                 double uz = ueta*cosh_eta + utau*sinh_eta;
                 double vz = uz/ut;
 
-                double T_local   = eos.get_temperature(e_local, rhob_local);
-                double s_local   = eos.get_entropy(e_local, rhob_local);
+                double T_local   = thermo.T;
+                double s_local   = thermo.entropy;
 
                 hydro_info_ptr.dump_ideal_info_to_memory(
                     tau, eta, e_local, p_local, s_local, T_local, vx, vy, vz);
@@ -413,7 +426,8 @@ void Cell_info::OutputEvolutionDataXYEta_memory(
 
 
 //! This function outputs hydro evolution file in binary format
-void Cell_info::OutputEvolutionDataXYEta_chun(SCGrid &arena, double tau) {
+template <class Cell>
+void Cell_infoT<Cell>::OutputEvolutionDataXYEta_chun(Grid &arena, double tau) {
     // the format of the file is as follows,
     //    itau ix iy ieta e P T cs^2 ux uy ueta
     // if turn_on_shear == 1:
@@ -442,8 +456,7 @@ void Cell_info::OutputEvolutionDataXYEta_chun(SCGrid &arena, double tau) {
     }
     out_file_xyeta = fopen(out_name_xyeta.c_str(), out_open_mode.c_str());
 
-    int n_skip_tau     = DATA.output_evolution_every_N_timesteps;
-    double output_dtau = DATA.delta_tau*n_skip_tau;
+    double output_dtau = DATA.delta_tau_output;
     int itau = static_cast<int>((tau - DATA.tau0)/(output_dtau) + 0.1);
 
     int n_skip_x       = DATA.output_evolution_every_N_x;
@@ -457,8 +470,10 @@ void Cell_info::OutputEvolutionDataXYEta_chun(SCGrid &arena, double tau) {
     const double output_dx     = DATA.delta_x*n_skip_x;
     const double output_dy     = DATA.delta_y*n_skip_y;
     const double output_deta   = DATA.delta_eta*n_skip_eta;
-    const double output_xmin   = - DATA.x_size/2.;
-    const double output_ymin   = - DATA.y_size/2.;
+    const double output_xmin   = (- DATA.x_size/2.
+                                  + arena.ix_input(0)*DATA.delta_x);
+    const double output_ymin   = (- DATA.y_size/2.
+                                  + arena.iy_input(0)*DATA.delta_y);
     const double output_etamin = - DATA.eta_size/2.;
 
     const int nVar_per_cell = (11 + DATA.turn_on_rhob*2 + DATA.turn_on_shear*5
@@ -591,7 +606,8 @@ void Cell_info::OutputEvolutionDataXYEta_chun(SCGrid &arena, double tau) {
 
 
 //! This function outputs hydro evolution file in binary format for photon production
-void Cell_info::OutputEvolutionDataXYEta_photon(SCGrid &arena, double tau) {
+template <class Cell>
+void Cell_infoT<Cell>::OutputEvolutionDataXYEta_photon(Grid &arena, double tau) {
     // volume = tau*dtau*dx*dy*deta
     // the format of the file is as follows,
     //    volume T ux uy ueta
@@ -619,15 +635,14 @@ void Cell_info::OutputEvolutionDataXYEta_photon(SCGrid &arena, double tau) {
     }
     out_file_xyeta = fopen(out_name_xyeta.c_str(), out_open_mode.c_str());
 
-    int n_skip_tau = DATA.output_evolution_every_N_timesteps;
     int n_skip_x = DATA.output_evolution_every_N_x;
     int n_skip_y = DATA.output_evolution_every_N_y;
     int n_skip_eta = DATA.output_evolution_every_N_eta;
-    double dtau = DATA.delta_tau;
+    double output_dtau = DATA.delta_tau_output;
     double dx = DATA.delta_x;
     double dy = DATA.delta_y;
     double deta = DATA.delta_eta;
-    double volume = tau*n_skip_tau*dtau*n_skip_x*dx*n_skip_y*dy*n_skip_eta*deta;
+    double volume = tau*output_dtau*n_skip_x*dx*n_skip_y*dy*n_skip_eta*deta;
 
     for (int ieta = 0; ieta < arena.nEta(); ieta += n_skip_eta) {
         double eta_local = - DATA.eta_size/2. + ieta*deta;
@@ -728,8 +743,10 @@ void Cell_info::OutputEvolutionDataXYEta_photon(SCGrid &arena, double tau) {
 
 
 //! This function outputs hydro evolution file in binary format
-void Cell_info::OutputEvolutionDataXYEta_vorticity(
-        SCGrid &arena_curr, SCGrid &arena_prev, double tau) {
+template <class Cell>
+void Cell_infoT<Cell>::OutputEvolutionDataXYEta_vorticity(
+        Grid &arena_curr, Grid &arena_prev, DerivedFieldSliceT<Cell> &fields,
+        double tau) {
     // the format of the file is as follows,
     //    itau ix iy ieta e P T ux uy ueta mu_B
     //    omega^tx omega^ty omega^tz omega^xy omega^xz omega^yz
@@ -744,8 +761,7 @@ void Cell_info::OutputEvolutionDataXYEta_vorticity(
     }
     out_file_xyeta = fopen(out_name_xyeta.c_str(), out_open_mode.c_str());
 
-    int n_skip_tau     = DATA.output_evolution_every_N_timesteps;
-    double output_dtau = DATA.delta_tau*n_skip_tau;
+    double output_dtau = DATA.delta_tau_output;
     int itau = static_cast<int>((tau - DATA.tau0)/(output_dtau) + 0.1);
 
     int n_skip_x       = DATA.output_evolution_every_N_x;
@@ -759,8 +775,10 @@ void Cell_info::OutputEvolutionDataXYEta_vorticity(
     const double output_dx     = DATA.delta_x*n_skip_x;
     const double output_dy     = DATA.delta_y*n_skip_y;
     const double output_deta   = DATA.delta_eta*n_skip_eta;
-    const double output_xmin   = - DATA.x_size/2.;
-    const double output_ymin   = - DATA.y_size/2.;
+    const double output_xmin   = (- DATA.x_size/2.
+                                  + arena_curr.ix_input(0)*DATA.delta_x);
+    const double output_ymin   = (- DATA.y_size/2.
+                                  + arena_curr.iy_input(0)*DATA.delta_y);
     const double output_etamin = - DATA.eta_size/2.;
 
     const int nVar_per_cell = 35;
@@ -777,6 +795,20 @@ void Cell_info::OutputEvolutionDataXYEta_vorticity(
             static_cast<float>(nVar_per_cell)};
         fwrite(header, sizeof(float), 12, out_file_xyeta);
     }
+
+    // the derivative fields of the cells written below
+    std::vector<int> cells;
+    for (int ieta = 0; ieta < arena_curr.nEta(); ieta += n_skip_eta)
+    for (int iy = 0; iy < arena_curr.nY(); iy += n_skip_y)
+    for (int ix = 0; ix < arena_curr.nX(); ix += n_skip_x) {
+        const double T_local = eos.get_temperature(
+                arena_curr(ix, iy, ieta).epsilon,
+                arena_curr(ix, iy, ieta).rhob)*hbarc;
+        if (T_local < DATA.output_evolution_T_cut) continue;
+        cells.push_back(fields.cell_index(ix, iy, ieta));
+    }
+    fields.add(DATA.delta_tau_prev, arena_prev, arena_curr, cells);
+
     for (int ieta = 0; ieta < arena_curr.nEta(); ieta += n_skip_eta) {
         double eta_local = - DATA.eta_size/2. + ieta*DATA.delta_eta;
         for (int iy = 0; iy < arena_curr.nY(); iy += n_skip_y) {
@@ -797,15 +829,11 @@ void Cell_info::OutputEvolutionDataXYEta_vorticity(
 
                 double muB_local = eos.get_muB(e_local, rhob_local);
 
-                VorticityVec omega_kSP = {0.0};
-                VorticityVec omega_k   = {0.0};
-                VorticityVec omega_th  = {0.0};
-                VorticityVec omega_T   = {0.0};
-                VelocityShearVec sigma_munu = {0.0};
-                DmuMuBoverTVec DbetaMu = {0.0};
-                u_derivative_helper.compute_vorticity_shell(
-                    tau, arena_prev, arena_curr, ieta, ix, iy, eta_local,
-                    omega_kSP, omega_k, omega_th, omega_T, sigma_munu, DbetaMu);
+                const Cell_aux aux = fields.tz(ix, iy, ieta, eta_local);
+                const VorticityVec &omega_kSP = aux.omega_kSP;
+                const VorticityVec &omega_k   = aux.omega_k;
+                const VorticityVec &omega_th  = aux.omega_th;
+                const VorticityVec &omega_T   = aux.omega_T;
 
                 float ideal[] = {static_cast<float>(itau),
                                  static_cast<float>(ix/n_skip_x),
@@ -855,19 +883,19 @@ void Cell_info::OutputEvolutionDataXYEta_vorticity(
 
 //! This function prints to the screen the maximum local energy density,
 //! the maximum temperature in the current grid
-void Cell_info::get_maximum_energy_density(
-        SCGrid &arena, double &e_max, double &nB_max, double &Tmax) {
+template <class Cell>
+void Cell_infoT<Cell>::get_maximum_energy_density(
+        Grid &arena, double &e_max, double &nB_max, double &Tmax) {
     double eps_max  = 0.0;
     double rhob_max = 0.0;
     double T_max    = 0.0;
 
     // get the grid information
-    const int neta = arena.nEta();
     const int nx   = arena.nX();
     const int ny   = arena.nY();
 
     #pragma omp parallel for collapse(3) reduction(max:eps_max, rhob_max, T_max)
-    for (int ieta = 0; ieta < neta; ieta++)
+    for (int ieta = domain.ieta_begin(); ieta < domain.ieta_end(); ieta++)
     for (int ix = 0; ix < nx; ix++) 
     for (int iy = 0; iy < ny; iy++) {
         const auto eps_local  = arena(ix, iy, ieta).epsilon;
@@ -876,8 +904,9 @@ void Cell_info::get_maximum_energy_density(
         rhob_max = std::max(rhob_max, rhob_local);
         T_max    = std::max(T_max,    eos.get_temperature(eps_local, rhob_local));
     }
-    eps_max *= Util::hbarc;   // GeV/fm^3
-    T_max   *= Util::hbarc;   // GeV
+    eps_max  = domain.max(eps_max)*Util::hbarc;   // GeV/fm^3
+    rhob_max = domain.max(rhob_max);
+    T_max    = domain.max(T_max)*Util::hbarc;     // GeV
 
     if (eps_max > 1e5) {
         music_message << "The maximum e = " << eps_max << " < 1e5 GeV/fm^3";
@@ -897,23 +926,10 @@ void Cell_info::get_maximum_energy_density(
 
 
 //! This function computes global angular momentum at a give proper time
-void Cell_info::compute_angular_momentum(
-        SCGrid &arena, SCGrid &arena_prev, const double tau,
+template <class Cell>
+void Cell_infoT<Cell>::compute_angular_momentum(
+        Grid &arena, Grid &arena_prev, const double tau,
         const double eta_min, const double eta_max) {
-    ostringstream filename;
-    filename << "global_angular_momentum_eta_"
-             << eta_min << "_" << eta_max << ".dat";
-    ofstream output_file;
-    if (std::abs(tau - DATA.tau0) < 1e-10) {
-        // create new files at the first time step
-        output_file.open(filename.str().c_str(), std::ofstream::out);
-        output_file << "# tau[fm]  Lx[hbarc]  Ly[hbarc]  Lz[hbarc]  "
-                    << "L^{tx}[hbarc]  L^{ty}[hbarc]  L^{tz}[hbarc]"
-                    << std::endl;
-    } else {
-        output_file.open(filename.str().c_str(),
-                         std::fstream::out | std::fstream::app);
-    }
     double Lx  = 0.0;
     double Ly  = 0.0;
     double Lz  = 0.0;
@@ -923,17 +939,16 @@ void Cell_info::compute_angular_momentum(
     const double deta = DATA.delta_eta;
     const double dx   = DATA.delta_x;
     const double dy   = DATA.delta_y;
-    const int neta    = arena.nEta();
     const int nx      = arena.nX();
     const int ny      = arena.nY();
     #pragma omp parallel for collapse(3) reduction(+:Lx, Ly, Lz, Ltx, Lty, Ltz)
-    for (int ieta = 0; ieta < neta; ieta++)
+    for (int ieta = domain.ieta_begin(); ieta < domain.ieta_end(); ieta++)
     for (int ix = 0; ix < nx; ix++)
     for (int iy = 0; iy < ny; iy++) {
         const auto& c      = arena     (ix, iy, ieta);
         const auto& c_prev = arena_prev(ix, iy, ieta);
 
-        double eta_s = deta*ieta - (DATA.eta_size)/2.0;
+        double eta_s = deta*arena.ieta_input(ieta) - (DATA.eta_size)/2.0;
         if (DATA.boost_invariant) {
             eta_s = 0.0;
         }
@@ -941,8 +956,8 @@ void Cell_info::compute_angular_momentum(
         const double cosh_eta = cosh(eta_s);
         const double sinh_eta = sinh(eta_s);
         const double t_local = tau*cosh_eta;
-        const double x_local = DATA.x_size/2. + ix*dx;
-        const double y_local = DATA.x_size/2. + iy*dy;
+        const double x_local = -DATA.x_size/2. + arena.ix_input(ix)*dx;
+        const double y_local = -DATA.y_size/2. + arena.iy_input(iy)*dy;
         const double z_local = tau*sinh_eta;
 
         const double e_local   = c.epsilon;
@@ -984,8 +999,24 @@ void Cell_info::compute_angular_momentum(
     Ltx *= factor;
     Lty *= factor;
     Ltz *= factor;
+    domain.sum({&Lx, &Ly, &Lz, &Ltx, &Lty, &Ltz});
+    if (!domain.is_root()) return;
 
     // output results
+    ostringstream filename;
+    filename << "global_angular_momentum_eta_"
+             << eta_min << "_" << eta_max << ".dat";
+    ofstream output_file;
+    if (std::abs(tau - DATA.tau0) < 1e-10) {
+        // create new files at the first time step
+        output_file.open(filename.str().c_str(), std::ofstream::out);
+        output_file << "# tau[fm]  Lx[hbarc]  Ly[hbarc]  Lz[hbarc]  "
+                    << "L^{tx}[hbarc]  L^{ty}[hbarc]  L^{tz}[hbarc]"
+                    << std::endl;
+    } else {
+        output_file.open(filename.str().c_str(),
+                         std::fstream::out | std::fstream::app);
+    }
     output_file << scientific << setprecision(6)
                 << tau << "  " << Lx << "  " << Ly << "  " << Lz << "  "
                 << Ltx << "  " << Lty << "  " << Ltz << std::endl;
@@ -995,18 +1026,10 @@ void Cell_info::compute_angular_momentum(
 
 //! This function checks the total energy and total net baryon number
 //! at a give proper time
-void Cell_info::check_conservation_law(SCGrid &arena, SCGrid &arena_prev,
-                                       const double tau) {
-    std::string filename = "global_conservation_laws.dat";
-    ofstream output_file;
-    if (std::abs(tau - DATA.tau0) < 1e-10) {
-        output_file.open(filename.c_str(), std::ofstream::out);
-        output_file << "# tau(fm)  E(GeV)  Px(GeV)  Py(GeV)  Pz(GeV)  N_B "
-                    << std::endl;
-    } else {
-        output_file.open(filename.c_str(),
-                         std::fstream::out | std::fstream::app);
-    }
+template <class Cell>
+void Cell_infoT<Cell>::check_conservation_law(Grid &arena, Grid &arena_prev,
+                                              const double tau,
+                                              const GridBox &box) {
     double N_B     = 0.0;
     double T_tau_t = 0.0;
     double T_tau_x = 0.0;
@@ -1020,21 +1043,18 @@ void Cell_info::check_conservation_law(SCGrid &arena, SCGrid &arena_prev,
     double deta    = DATA.delta_eta;
     double dx      = DATA.delta_x;
     double dy      = DATA.delta_y;
-    const int neta = arena.nEta();
     const int nx   = arena.nX();
     const int ny   = arena.nY();
 
-    #pragma omp parallel for collapse(3) reduction(+:N_B, T_tau_t, T_tau_x, T_tau_y, T_tau_z, N_B_edge, T_tau_t_edge, T_tau_x_edge, T_tau_y_edge, T_tau_z_edge)
-    for (int ieta = 0; ieta < neta; ieta++)
-    for (int ix = 0; ix < nx; ix++)
-    for (int iy = 0; iy < ny; iy++) {
+    // T^{tau t}, T^{tau x}, T^{tau y}, T^{tau z} and J^tau of a cell
+    auto local_Pmu = [&](const int ix, const int iy, const int ieta) {
         const auto& c      = arena     (ix, iy, ieta);
         const auto& c_prev = arena_prev(ix, iy, ieta);
 
-        const double eta_s = deta*ieta - (DATA.eta_size)/2.0;
+        const double eta_s = (deta*arena.ieta_input(ieta)
+                              - (DATA.eta_size)/2.0);
         const double cosh_eta = cosh(eta_s);
         const double sinh_eta = sinh(eta_s);
-        N_B += (c.rhob*c.u[0] + c_prev.Wmunu[10]);
         const double e_local   = c.epsilon;
         const double rhob      = c.rhob;
         const double pressure  = eos.get_pressure(e_local, rhob);
@@ -1053,21 +1073,47 @@ void Cell_info::check_conservation_law(SCGrid &arena, SCGrid &arena_prev,
                                   + c_prev.pi_b*c_prev.u[0]*c_prev.u[2]);
         const double T_tau_eta = ((e_local + pressure)*u0*u3 + c_prev.Wmunu[3]
                                   + c_prev.pi_b*c_prev.u[0]*c_prev.u[3]);
-        T_tau_t += T_tau_tau*cosh_eta + T_tau_eta*sinh_eta;
-        T_tau_x += T01_local;
-        T_tau_y += T02_local;
-        T_tau_z += T_tau_tau*sinh_eta + T_tau_eta*cosh_eta;
-
-        // compute the energy-momentum vector on the edge
-        if (ieta == 0 || ieta == neta - 1 || ix == 0 || ix == nx - 1
-            || iy == 0 || iy == ny - 1) {
-            N_B_edge     += c.rhob*c.u[0] + c_prev.Wmunu[10];
-            T_tau_t_edge += T_tau_tau*cosh_eta + T_tau_eta*sinh_eta;
-            T_tau_x_edge += T01_local;
-            T_tau_y_edge += T02_local;
-            T_tau_z_edge += T_tau_tau*sinh_eta + T_tau_eta*cosh_eta;
+        return std::array<double, 5>{
+            T_tau_tau*cosh_eta + T_tau_eta*sinh_eta, T01_local, T02_local,
+            T_tau_tau*sinh_eta + T_tau_eta*cosh_eta,
+            c.rhob*c.u[0] + c_prev.Wmunu[10]};
+    };
+
+    // the cells outside box are not evolved and keep their values
+    #pragma omp parallel for collapse(3) reduction(+:N_B, T_tau_t, T_tau_x, T_tau_y, T_tau_z)
+    for (int ieta = box.lo[2]; ieta < box.hi[2]; ieta++)
+    for (int ix = box.lo[0]; ix < box.hi[0]; ix++)
+    for (int iy = box.lo[1]; iy < box.hi[1]; iy++) {
+        const auto Pmu = local_Pmu(ix, iy, ieta);
+        T_tau_t += Pmu[0];
+        T_tau_x += Pmu[1];
+        T_tau_y += Pmu[2];
+        T_tau_z += Pmu[3];
+        N_B     += Pmu[4];
+    }
+
+    // compute the energy-momentum vector on the edge of the whole grid,
+    // which may lie outside box
+    #pragma omp parallel for collapse(2) reduction(+:N_B_edge, T_tau_t_edge, T_tau_x_edge, T_tau_y_edge, T_tau_z_edge)
+    for (int ieta = domain.ieta_begin(); ieta < domain.ieta_end(); ieta++)
+    for (int iy = 0; iy < ny; iy++) {
+        const int ieta_input = arena.ieta_input(ieta);
+        const bool edge_eta_y = (   ieta_input == 0
+                                 || ieta_input == DATA.neta - 1
+                                 || iy == 0 || iy == ny - 1);
+        const int ix_step = edge_eta_y ? 1 : std::max(nx - 1, 1);
+        for (int ix = 0; ix < nx; ix += ix_step) {
+            const auto Pmu = local_Pmu(ix, iy, ieta);
+            T_tau_t_edge += Pmu[0];
+            T_tau_x_edge += Pmu[1];
+            T_tau_y_edge += Pmu[2];
+            T_tau_z_edge += Pmu[3];
+            N_B_edge     += Pmu[4];
         }
     }
+    domain.sum({&N_B, &T_tau_t, &T_tau_x, &T_tau_y, &T_tau_z,
+                &N_B_edge, &T_tau_t_edge, &T_tau_x_edge, &T_tau_y_edge,
+                &T_tau_z_edge});
     // add units
     double factor = tau*dx*dy*deta;
     N_B *= factor;
@@ -1100,6 +1146,7 @@ void Cell_info::check_conservation_law(SCGrid &arena, SCGrid &arena_prev,
     Pmu_edge_prev[2] = T_tau_y_edge;
     Pmu_edge_prev[3] = T_tau_z_edge;
     Pmu_edge_prev[4] = N_B_edge;
+    if (!domain.is_root()) return;
 
     // output results
     music_message << "total energy T^{taut} = " << T_tau_t << " GeV";
@@ -1113,6 +1160,16 @@ void Cell_info::check_conservation_law(SCGrid &arena, SCGrid &arena_prev,
         music_message.flush("error");
         exit(1);
     }
+    std::string filename = "global_conservation_laws.dat";
+    ofstream output_file;
+    if (std::abs(tau - DATA.tau0) < 1e-10) {
+        output_file.open(filename.c_str(), std::ofstream::out);
+        output_file << "# tau(fm)  E(GeV)  Px(GeV)  Py(GeV)  Pz(GeV)  N_B "
+                    << std::endl;
+    } else {
+        output_file.open(filename.c_str(),
+                         std::fstream::out | std::fstream::app);
+    }
     output_file << scientific << setprecision(6)
                 << tau << "  " << T_tau_t << "  " << T_tau_x << "  "
                 << T_tau_y << "  " << T_tau_z << "  " << N_B << std::endl;
@@ -1121,7 +1178,8 @@ void Cell_info::check_conservation_law(SCGrid &arena, SCGrid &arena_prev,
 
 
 //! This function putputs files to check with Gubser flow solution
-void Cell_info::Gubser_flow_check_file(SCGrid &arena, const double tau) {
+template <class Cell>
+void Cell_infoT<Cell>::Gubser_flow_check_file(Grid &arena, const double tau) {
     if (tau > 1.) {
         ostringstream filename_analytic;
         filename_analytic << "tests/Gubser_flow/y=x_tau="
@@ -1192,9 +1250,9 @@ void Cell_info::Gubser_flow_check_file(SCGrid &arena, const double tau) {
     ofstream output_file(filename.str().c_str());
 
     double dx = DATA.delta_x;
-    double x_min = -DATA.x_size/2.;
+    double x_min = -DATA.x_size/2. + arena.ix_input(0)*dx;
     double dy = DATA.delta_y;
-    double y_min = -DATA.y_size/2.;
+    double y_min = -DATA.y_size/2. + arena.iy_input(0)*dy;
     for (int ix = 0; ix < arena.nX(); ix++)
     for (int iy = 0; iy < arena.nY(); iy++) {
         double x_local = x_min + ix*dx;
@@ -1219,7 +1277,8 @@ void Cell_info::Gubser_flow_check_file(SCGrid &arena, const double tau) {
 
 
 //! This function outputs files to cross check with 1+1D simulation
-void Cell_info::output_1p1D_check_file(SCGrid &arena, const double tau) {
+template <class Cell>
+void Cell_infoT<Cell>::output_1p1D_check_file(Grid &arena, const double tau) {
     ostringstream filename;
     filename << "1+1D_check_tau_" << tau << ".dat";
     ofstream output_file(filename.str().c_str());
@@ -1240,7 +1299,8 @@ void Cell_info::output_1p1D_check_file(SCGrid &arena, const double tau) {
 
 
 //! This function outputs energy density and n_b for making movies
-void Cell_info::output_evolution_for_movie(SCGrid &arena, const double tau) {
+template <class Cell>
+void Cell_infoT<Cell>::output_evolution_for_movie(Grid &arena, const double tau) {
     const string out_name_xyeta = "evolution_for_movie_xyeta.dat";
     string out_open_mode;
     FILE *out_file_xyeta;
@@ -1252,8 +1312,7 @@ void Cell_info::output_evolution_for_movie(SCGrid &arena, const double tau) {
     }
     out_file_xyeta = fopen(out_name_xyeta.c_str(), out_open_mode.c_str());
 
-    int n_skip_tau = DATA.output_evolution_every_N_timesteps;
-    double output_dtau = DATA.delta_tau*n_skip_tau;
+    double output_dtau = DATA.delta_tau_output;
     int itau = static_cast<int>((tau - DATA.tau0)/(output_dtau) + 0.1);
 
     int n_skip_x   = DATA.output_evolution_every_N_x;
@@ -1274,8 +1333,10 @@ void Cell_info::output_evolution_for_movie(SCGrid &arena, const double tau) {
         const double output_dx     = DATA.delta_x*n_skip_x;
         const double output_dy     = DATA.delta_y*n_skip_y;
         const double output_deta   = DATA.delta_eta*n_skip_eta;
-        const double output_xmin   = - DATA.x_size/2.;
-        const double output_ymin   = - DATA.y_size/2.;
+        const double output_xmin   = (- DATA.x_size/2.
+                                      + arena.ix_input(0)*DATA.delta_x);
+        const double output_ymin   = (- DATA.y_size/2.
+                                      + arena.iy_input(0)*DATA.delta_y);
         const double output_etamin = - DATA.eta_size/2.;
         float header[] = {
             static_cast<float>(DATA.tau0), static_cast<float>(output_dtau),
@@ -1342,8 +1403,9 @@ void Cell_info::output_evolution_for_movie(SCGrid &arena, const double tau) {
 
 
 //! This function dumps the energy density and net baryon density
-void Cell_info::output_energy_density_and_rhob_disitrubtion(SCGrid &arena,
-                                                            string filename) {
+template <class Cell>
+void Cell_infoT<Cell>::output_energy_density_and_rhob_disitrubtion(Grid &arena,
+                                                                   string filename) {
     ofstream output_file(filename.c_str());
     const int n_skip_x   = DATA.output_evolution_every_N_x;
     const int n_skip_y   = DATA.output_evolution_every_N_y;
@@ -1362,9 +1424,11 @@ void Cell_info::output_energy_density_and_rhob_disitrubtion(SCGrid &arena,
 
 //! This function outputs the evolution of hydrodynamic variables at a
 //! give fluid cell
-void Cell_info::monitor_a_fluid_cell(SCGrid &arena_curr, SCGrid &arena_prev,
-                                     const int ix, const int iy,
-                                     const int ieta, const double tau) {
+template <class Cell>
+void Cell_infoT<Cell>::monitor_a_fluid_cell(Grid &arena_curr, Grid &arena_prev,
+                                            DerivedFieldSliceT<Cell> &fields,
+                                            const int ix, const int iy,
+                                            const int ieta, const double tau) {
     ostringstream filename;
     filename << "monitor_fluid_cell_ix_" << ix << "_iy_" << iy
              << "_ieta_" << ieta << ".dat";
@@ -1388,21 +1452,13 @@ void Cell_info::monitor_a_fluid_cell(SCGrid &arena_curr, SCGrid &arena_prev,
                     << arena_curr(ix, iy, ieta).u[i] << "  ";
     }
 
-    u_derivative_helper.MakedU(tau, arena_prev, arena_curr, ix, iy, ieta);
-    auto theta_local = u_derivative_helper.calculate_expansion_rate(
-                                            tau, arena_curr, ieta, ix, iy);
+    fields.add(DATA.delta_tau_prev, arena_prev, arena_curr, ix, iy, ieta);
+    const ViscousGradients &grad = fields(ix, iy, ieta).grad;
     output_file << scientific << setprecision(8)
                 << arena_curr(ix, iy, ieta).pi_b*Util::hbarc << "  "
-                << theta_local << "  ";
-    DumuVec a_local;
-    u_derivative_helper.calculate_Du_supmu(tau, arena_curr,
-                                           ieta, ix, iy, a_local);
-    VelocityShearVec sigma_local;
-    u_derivative_helper.calculate_velocity_shear_tensor(
-                    tau, arena_curr, ieta, ix, iy, a_local, sigma_local);
-    VorticityVec omega_local;
-    u_derivative_helper.calculate_kinetic_vorticity_with_spatial_projector(
-                    tau, arena_curr, ieta, ix, iy, a_local, omega_local);
+                << grad.theta << "  ";
+    const VelocityShearVec &sigma_local = grad.sigma;
+    const VorticityVec &omega_local = grad.omega;
     for (int i = 0; i < 10; i++) {
         output_file << scientific << setprecision(8)
                     << arena_curr(ix, iy, ieta).Wmunu[i]*Util::hbarc << "  "
@@ -1416,8 +1472,37 @@ void Cell_info::monitor_a_fluid_cell(SCGrid &arena_curr, SCGrid &arena_prev,
     output_file.close();
 }
 
-void Cell_info::output_vorticity_distribution(
-                SCGrid &arena_curr, SCGrid &arena_prev, const double tau,
+//! adds the cells read by the vorticity outputs, e >= 0.1/fm^4 with
+//! eta_min < eta < eta_max, in the rows ieta_begin <= ieta < ieta_end to
+//! fields
+template <class Cell>
+void Cell_infoT<Cell>::add_vorticity_cells(
+                Grid &arena_curr, Grid &arena_prev,
+                DerivedFieldSliceT<Cell> &fields,
+                const double eta_min, const double eta_max,
+                const int ieta_begin, const int ieta_end) {
+    std::vector<int> cells;
+    for (int ieta = ieta_begin; ieta < ieta_end; ieta++) {
+        double eta = 0.0;
+        if (!DATA.boost_invariant) {
+            eta = ((static_cast<double>(arena_curr.ieta_input(ieta)))
+                    *(DATA.delta_eta) - (DATA.eta_size)/2.0);
+        }
+        if (eta < eta_max && eta > eta_min) {
+            for (int iy = 0; iy < arena_curr.nY(); iy++)
+            for (int ix = 0; ix < arena_curr.nX(); ix++) {
+                if (arena_curr(ix, iy, ieta).epsilon < 0.1) continue;
+                cells.push_back(fields.cell_index(ix, iy, ieta));
+            }
+        }
+    }
+    fields.add(DATA.delta_tau_prev, arena_prev, arena_curr, cells);
+}
+
+template <class Cell>
+void Cell_infoT<Cell>::output_vorticity_distribution(
+                Grid &arena_curr, Grid &arena_prev,
+                DerivedFieldSliceT<Cell> &fields, const double tau,
                 const double eta_min, const double eta_max) {
     // This function outputs the vorticity tensor at a given tau
     ostringstream filename1;
@@ -1461,10 +1546,14 @@ void Cell_info::output_vorticity_distribution(
         << "omega^{tz}/T^2  omega^{xy}/T^2  omega^{xz}/T^2  "
         << "omega^{yz}/T^2" << std::endl;
 
+    add_vorticity_cells(arena_curr, arena_prev, fields, eta_min, eta_max,
+                        0, arena_curr.nEta());
     for (int ix = 0; ix < arena_curr.nX(); ix++) {
         for (int iy = 0; iy < arena_curr.nY(); iy++) {
-            const double x_local = -DATA.x_size/2. + ix*DATA.delta_x;
-            const double y_local = -DATA.y_size/2. + iy*DATA.delta_y;
+            const double x_local = (-DATA.x_size/2.
+                                    + arena_curr.ix_input(ix)*DATA.delta_x);
+            const double y_local = (-DATA.y_size/2.
+                                    + arena_curr.iy_input(iy)*DATA.delta_y);
 
             VorticityVec omega_kSP = {0.0};
             VorticityVec omega_k   = {0.0};
@@ -1487,14 +1576,11 @@ void Cell_info::output_vorticity_distribution(
                     T_avg += e_local*T_local*hbarc;
                     muB_avg += e_local*muB_local*hbarc;
 
-                    VorticityVec omega_local_1, omega_local_2;
-                    VorticityVec omega_local_3, omega_local_4;
-                    VelocityShearVec sigma_local = {0.0};
-                    DmuMuBoverTVec DbetaMu = {0.0};
-                    u_derivative_helper.compute_vorticity_shell(
-                        tau, arena_prev, arena_curr, ieta, ix, iy, eta_local,
-                        omega_local_1, omega_local_2,
-                        omega_local_3, omega_local_4, sigma_local, DbetaMu);
+                    const Cell_aux aux = fields.tz(ix, iy, ieta, eta_local);
+                    const VorticityVec &omega_local_1 = aux.omega_kSP;
+                    const VorticityVec &omega_local_2 = aux.omega_k;
+                    const VorticityVec &omega_local_3 = aux.omega_th;
+                    const VorticityVec &omega_local_4 = aux.omega_T;
                     for (unsigned int ii = 0; ii < omega_k.size(); ii++) {
                         omega_kSP[ii] += e_local*omega_local_1[ii]/T_local;
                         omega_k[ii]   += e_local*omega_local_2[ii]/T_local;
@@ -1544,10 +1630,57 @@ void Cell_info::output_vorticity_distribution(
     of4.close();
 }
 
-void Cell_info::output_vorticity_time_evolution(
-                SCGrid &arena_curr, SCGrid &arena_prev, const double tau,
+template <class Cell>
+void Cell_infoT<Cell>::output_vorticity_time_evolution(
+                Grid &arena_curr, Grid &arena_prev,
+                DerivedFieldSliceT<Cell> &fields, const double tau,
                 const double eta_min, const double eta_max) {
     // This function outputs the time evolution of the vorticity tensor
+    add_vorticity_cells(arena_curr, arena_prev, fields, eta_min, eta_max,
+                        domain.ieta_begin(), domain.ieta_end());
+    VorticityVec omega_kSP = {0.0};
+    VorticityVec omega_k   = {0.0};
+    VorticityVec omega_th  = {0.0};
+    VorticityVec omega_T   = {0.0};
+    double weight = 0.0;
+    for (int ieta = domain.ieta_begin(); ieta < domain.ieta_end(); ieta++) {
+        double eta = 0.0;
+        if (!DATA.boost_invariant) {
+            eta = ((static_cast<double>(arena_curr.ieta_input(ieta)))
+                    *(DATA.delta_eta) - (DATA.eta_size)/2.0);
+        }
+        if (eta < eta_max && eta > eta_min) {
+            for (int iy = 0; iy < arena_curr.nY(); iy++)
+            for (int ix = 0; ix < arena_curr.nX(); ix++) {
+                const double e_local = arena_curr(ix, iy, ieta).epsilon;
+                if (e_local < 0.1) continue;
+                const double rhob_local = arena_curr(ix, iy, ieta).rhob;
+                const double T_local = (
+                            eos.get_temperature(e_local, rhob_local));
+                const Cell_aux aux = fields.tz(ix, iy, ieta, eta);
+                const VorticityVec &omega_local_1 = aux.omega_kSP;
+                const VorticityVec &omega_local_2 = aux.omega_k;
+                const VorticityVec &omega_local_3 = aux.omega_th;
+                const VorticityVec &omega_local_4 = aux.omega_T;
+                for (unsigned int ii = 0; ii < omega_k.size(); ii++) {
+                    omega_kSP[ii] += e_local*omega_local_1[ii]/T_local;
+                    omega_k[ii]   += e_local*omega_local_2[ii]/T_local;
+                    omega_th[ii]  += e_local*omega_local_3[ii];
+                    omega_T[ii]   += e_local*omega_local_4[ii]/T_local/T_local;
+                }
+                weight += e_local;
+            }
+        }
+    }
+    std::vector<double*> sums = {&weight};
+    for (unsigned int ii = 0; ii < omega_k.size(); ii++) {
+        sums.insert(sums.end(), {&omega_kSP[ii], &omega_k[ii],
+                                 &omega_th[ii], &omega_T[ii]});
+    }
+    domain.sum(sums);
+    if (!domain.is_root()) return;
+    weight = std::max(weight, small_eps);
+
     ostringstream filename1;
     filename1 << "vorticity_evo_kinetic_wSP_eta_" << eta_min
               << "_" << eta_max << ".dat";
@@ -1601,45 +1734,6 @@ void Cell_info::output_vorticity_time_evolution(
                  std::fstream::out | std::fstream::app);
     }
 
-    VorticityVec omega_kSP = {0.0};
-    VorticityVec omega_k   = {0.0};
-    VorticityVec omega_th  = {0.0};
-    VorticityVec omega_T   = {0.0};
-    double weight = 0.0;
-    for (int ieta = 0; ieta < arena_curr.nEta(); ieta++) {
-        double eta = 0.0;
-        if (!DATA.boost_invariant) {
-            eta = ((static_cast<double>(ieta))*(DATA.delta_eta)
-                    - (DATA.eta_size)/2.0);
-        }
-        if (eta < eta_max && eta > eta_min) {
-            for (int iy = 0; iy < arena_curr.nY(); iy++)
-            for (int ix = 0; ix < arena_curr.nX(); ix++) {
-                const double e_local = arena_curr(ix, iy, ieta).epsilon;
-                if (e_local < 0.1) continue;
-                const double rhob_local = arena_curr(ix, iy, ieta).rhob;
-                const double T_local = (
-                            eos.get_temperature(e_local, rhob_local));
-                VorticityVec omega_local_1, omega_local_2;
-                VorticityVec omega_local_3, omega_local_4;
-                VelocityShearVec sigma_local = {0.0};
-                DmuMuBoverTVec DbetaMu = {0.0};
-                u_derivative_helper.compute_vorticity_shell(
-                    tau, arena_prev, arena_curr, ieta, ix, iy, eta,
-                    omega_local_1, omega_local_2,
-                    omega_local_3, omega_local_4, sigma_local, DbetaMu);
-                for (unsigned int ii = 0; ii < omega_k.size(); ii++) {
-                    omega_kSP[ii] += e_local*omega_local_1[ii]/T_local;
-                    omega_k[ii]   += e_local*omega_local_2[ii]/T_local;
-                    omega_th[ii]  += e_local*omega_local_3[ii];
-                    omega_T[ii]   += e_local*omega_local_4[ii]/T_local/T_local;
-                }
-                weight += e_local;
-            }
-        }
-    }
-    weight = std::max(weight, small_eps);
-
     of1 << scientific << setw(18) << setprecision(8) << tau << "  ";
     of2 << scientific << setw(18) << setprecision(8) << tau << "  ";
     of3 << scientific << setw(18) << setprecision(8) << tau << "  ";
@@ -1669,7 +1763,8 @@ void Cell_info::output_vorticity_time_evolution(
 }
 
 
-void Cell_info::load_deltaf_qmu_coeff_table(string filename) {
+template <class Cell>
+void Cell_infoT<Cell>::load_deltaf_qmu_coeff_table(string filename) {
     std::ifstream table(filename.c_str());
     deltaf_qmu_coeff_table_length_T = 150;
     deltaf_qmu_coeff_table_length_mu = 100;
@@ -1689,7 +1784,8 @@ void Cell_info::load_deltaf_qmu_coeff_table(string filename) {
 }
 
 
-void Cell_info::load_deltaf_qmu_coeff_table_14mom(string filename) {
+template <class Cell>
+void Cell_infoT<Cell>::load_deltaf_qmu_coeff_table_14mom(string filename) {
     std::ifstream table(filename.c_str());
     deltaf_coeff_table_14mom_length_T = 190;
     deltaf_coeff_table_14mom_length_mu = 160;
@@ -1754,7 +1850,8 @@ void Cell_info::load_deltaf_qmu_coeff_table_14mom(string filename) {
 }
 
 
-double Cell_info::get_deltaf_qmu_coeff(double T, double muB) {
+template <class Cell>
+double Cell_infoT<Cell>::get_deltaf_qmu_coeff(double T, double muB) {
     if (muB < 0) {
        muB = -muB;
     }
@@ -1786,8 +1883,9 @@ double Cell_info::get_deltaf_qmu_coeff(double T, double muB) {
 }
 
 
-double Cell_info::get_deltaf_coeff_14moments(double T, double muB,
-                                             double type) {
+template <class Cell>
+double Cell_infoT<Cell>::get_deltaf_coeff_14moments(double T, double muB,
+                                                    double type) {
     int idx_T = static_cast<int>(
                 (T - delta_coeff_table_14mom_T0)/delta_coeff_table_14mom_dT);
     int idx_mu = static_cast<int>(
@@ -1832,21 +1930,10 @@ double Cell_info::get_deltaf_coeff_14moments(double T, double muB,
 
 //! This function outputs average T and mu_B as a function of proper tau
 //! within a given space-time rapidity range
-void Cell_info::output_average_phase_diagram_trajectory(
+template <class Cell>
+void Cell_infoT<Cell>::output_average_phase_diagram_trajectory(
         const double tau, const double eta_min, const double eta_max,
-        SCGrid &arena) {
-    ostringstream filename;
-    filename << "averaged_phase_diagram_trajectory_eta_" << eta_min
-             << "_" << eta_max << ".dat";
-    std::fstream of;
-    if (std::abs(tau - DATA.tau0) < 1e-10) {
-        of.open(filename.str().c_str(), std::fstream::out);
-        of << "# tau(fm)  <T>(GeV)  std(T)(GeV)  <mu_B>(GeV)  std(mu_B)(GeV)  "
-           << "V4 (fm^4)" << endl;
-    } else {
-        of.open(filename.str().c_str(),
-                std::fstream::out | std::fstream::app);
-    }
+        Grid &arena) {
     double avg_T  = 0.0;
     double avg_mu = 0.0;
     double std_T  = 0.0;
@@ -1854,11 +1941,11 @@ void Cell_info::output_average_phase_diagram_trajectory(
     double weight = 0.0;
     double V4     = 0.0;
     const double unit_volume = tau*DATA.delta_x*DATA.delta_y*DATA.delta_eta;
-    for (int ieta = 0; ieta < arena.nEta(); ieta++) {
+    for (int ieta = domain.ieta_begin(); ieta < domain.ieta_end(); ieta++) {
         double eta = 0.0;
         if (!DATA.boost_invariant) {
-            eta = ((static_cast<double>(ieta))*(DATA.delta_eta)
-                    - (DATA.eta_size)/2.0);
+            eta = ((static_cast<double>(arena.ieta_input(ieta)))
+                    *(DATA.delta_eta) - (DATA.eta_size)/2.0);
         }
         if (eta < eta_max && eta > eta_min) {
             double cosh_eta = cosh(eta);
@@ -1883,6 +1970,21 @@ void Cell_info::output_average_phase_diagram_trajectory(
             }
         }
     }
+    domain.sum({&avg_T, &avg_mu, &std_T, &std_mu, &weight, &V4});
+    if (!domain.is_root()) return;
+
+    ostringstream filename;
+    filename << "averaged_phase_diagram_trajectory_eta_" << eta_min
+             << "_" << eta_max << ".dat";
+    std::fstream of;
+    if (std::abs(tau - DATA.tau0) < 1e-10) {
+        of.open(filename.str().c_str(), std::fstream::out);
+        of << "# tau(fm)  <T>(GeV)  std(T)(GeV)  <mu_B>(GeV)  std(mu_B)(GeV)  "
+           << "V4 (fm^4)" << endl;
+    } else {
+        of.open(filename.str().c_str(),
+                std::fstream::out | std::fstream::app);
+    }
     avg_T  = avg_T/std::max(weight, small_eps)*hbarc;
     avg_mu = avg_mu/std::max(weight, small_eps)*hbarc;
     std_T  = sqrt(std_T/std::max(weight, small_eps)*hbarc*hbarc - avg_T*avg_T);
@@ -1896,8 +1998,9 @@ void Cell_info::output_average_phase_diagram_trajectory(
 
 //! This function outputs system's eccentricity and momentum anisotropy
 //! as functions of eta_s
-void Cell_info::output_momentum_anisotropy_vs_etas(
-                const double tau, SCGrid &arena) const {
+template <class Cell>
+void Cell_infoT<Cell>::output_momentum_anisotropy_vs_etas(
+                const double tau, Grid &arena) const {
     ostringstream filename;
     filename << "momentum_anisotropy_tau_" << tau << ".dat";
     std::fstream of;
@@ -1939,8 +2042,8 @@ void Cell_info::output_momentum_anisotropy_vs_etas(
         double w_ed_sum = 0.0, w_nB_sum = 0.0;
         for (int iy = 0; iy < arena.nY(); iy++)
         for (int ix = 0; ix < arena.nX(); ix++) {
-            double x_local    = - DATA.x_size/2. + ix*DATA.delta_x;
-            double y_local    = - DATA.y_size/2. + iy*DATA.delta_y;
+            double x_local    = - DATA.x_size/2. + arena.ix_input(ix)*DATA.delta_x;
+            double y_local    = - DATA.y_size/2. + arena.iy_input(iy)*DATA.delta_y;
             double e_local    = arena(ix, iy, ieta).epsilon;  // 1/fm^4
             double nB_local   = arena(ix, iy, ieta).rhob;     // 1/fm^3
             double gamma_perp = arena(ix, iy, ieta).u[0];
@@ -1973,10 +2076,10 @@ void Cell_info::output_momentum_anisotropy_vs_etas(
         std::vector<double> meanpT_est_den(1, 0.0);
         for (int iy = 0; iy < arena.nY(); iy++)
         for (int ix = 0; ix < arena.nX(); ix++) {
-            double x_ed = - DATA.x_size/2. + ix*DATA.delta_x - x_ed_o;
-            double y_ed = - DATA.y_size/2. + iy*DATA.delta_y - y_ed_o;
-            double x_nB = - DATA.x_size/2. + ix*DATA.delta_x - x_nB_o;
-            double y_nB = - DATA.y_size/2. + iy*DATA.delta_y - y_nB_o;
+            double x_ed = - DATA.x_size/2. + arena.ix_input(ix)*DATA.delta_x - x_ed_o;
+            double y_ed = - DATA.y_size/2. + arena.iy_input(iy)*DATA.delta_y - y_ed_o;
+            double x_nB = - DATA.x_size/2. + arena.ix_input(ix)*DATA.delta_x - x_nB_o;
+            double y_nB = - DATA.y_size/2. + arena.iy_input(iy)*DATA.delta_y - y_nB_o;
             double r_ed = sqrt(x_ed*x_ed + y_ed*y_ed);
             double r_nB = sqrt(x_nB*x_nB + y_nB*y_nB);
             double phi_ed = atan2(y_ed, x_ed);
@@ -2089,67 +2192,10 @@ void Cell_info::output_momentum_anisotropy_vs_etas(
 
 
 //! This function outputs system's momentum anisotropy as a function of tau
-void Cell_info::output_momentum_anisotropy_vs_tau(
+template <class Cell>
+void Cell_infoT<Cell>::output_momentum_anisotropy_vs_tau(
                 const double tau, const double eta_min, const double eta_max,
-                SCGrid &arena) const {
-    ostringstream filename;
-    filename << "momentum_anisotropy_eta_" << eta_min
-             << "_" << eta_max << ".dat";
-    std::fstream of;
-    if (std::abs(tau - DATA.tau0) < 1e-10) {
-        of.open(filename.str().c_str(), std::fstream::out);
-        of << "# tau(fm)  epsilon_p(ideal)(cos)  epsilon_p(ideal)(sin)  "
-           << "epsilon_p(shear)(cos)  epsilon_p(shear)(sin)  "
-           << "epsilon_p(full)(cos)  epsilon_p(full)(sin)  "
-           << "epsilon_2p(ideal)(cos)  epsilon_2p(ideal)(sin)  "
-           << "epsilon_2p(shear)(cos)  epsilon_2p(shear)(sin)  "
-           << "epsilon_2p(full)(cos)  epsilon_2p(full)(sin)  "
-           << "epsilon_3p(ideal)(cos)  epsilon_3p(ideal)(sin)  "
-           << "epsilon_3p(shear)(cos)  epsilon_3p(shear)(sin)  "
-           << "epsilon_3p(full)(cos)  epsilon_3p(full)(sin)  "
-           << endl;
-    } else {
-        of.open(filename.str().c_str(),
-                std::fstream::out | std::fstream::app);
-    }
-
-    ostringstream filename1;
-    filename1 << "eccentricities_evo_eta_" << eta_min
-              << "_" << eta_max << ".dat";
-    std::fstream of1;
-    if (std::abs(tau - DATA.tau0) < 1e-10) {
-        of1.open(filename1.str().c_str(), std::fstream::out);
-        of1 << "# tau(fm)  ecc_n(cos)  ecc_n(sin) (n=1-6)"<< endl;
-    } else {
-        of1.open(filename1.str().c_str(),
-                 std::fstream::out | std::fstream::app);
-    }
-
-    ostringstream filename2;
-    filename2 << "inverse_Reynolds_number_eta_" << eta_min
-             << "_" << eta_max << ".dat";
-    std::fstream of2;
-    if (std::abs(tau - DATA.tau0) < 1e-10) {
-        of2.open(filename2.str().c_str(), std::fstream::out);
-        of2 << "# tau(fm)  R_shearpi  R_Pi  gamma  T[GeV]" << endl;
-    } else {
-        of2.open(filename2.str().c_str(),
-                 std::fstream::out | std::fstream::app);
-    }
-
-    ostringstream filename3;
-    filename3 << "meanpT_estimators_eta_" << eta_min << "_" << eta_max
-              << ".dat";
-    std::fstream of3;
-    if (std::abs(tau - DATA.tau0) < 1e-10) {
-        of3.open(filename3.str().c_str(), std::fstream::out);
-        of3 << "# tau (fm)  dS/deta_s  dE/deta_s (GeV) [s] (1/fm^-3)  "
-            << "[r^2] (fm^2)" << endl;
-    } else {
-        of3.open(filename3.str().c_str(),
-                 std::fstream::out | std::fstream::app);
-    }
-
+                Grid &arena) const {
     double ideal_num1 = 0.0;
     double ideal_num2 = 0.0;
     double ideal_den  = 0.0;
@@ -2181,11 +2227,11 @@ void Cell_info::output_momentum_anisotropy_vs_tau(
     std::vector<double> eccn_den (norder, 0.0);
     std::vector<double> meanpT_est_num(4, 0.0);
     std::vector<double> meanpT_est_den(1, 0.0);
-    for (int ieta = 0; ieta < arena.nEta(); ieta++) {
+    for (int ieta = domain.ieta_begin(); ieta < domain.ieta_end(); ieta++) {
         double eta = 0.0;
         if (!DATA.boost_invariant) {
-            eta = ((static_cast<double>(ieta))*(DATA.delta_eta)
-                    - (DATA.eta_size)/2.0);
+            eta = ((static_cast<double>(arena.ieta_input(ieta)))
+                    *(DATA.delta_eta) - (DATA.eta_size)/2.0);
         }
         if (eta < eta_max && eta > eta_min) {
             double x_o   = 0.0;
@@ -2193,8 +2239,8 @@ void Cell_info::output_momentum_anisotropy_vs_tau(
             double w_sum = 0.0;
             for (int iy = 0; iy < arena.nY(); iy++)
             for (int ix = 0; ix < arena.nX(); ix++) {
-                double x_local    = - DATA.x_size/2. + ix*DATA.delta_x;
-                double y_local    = - DATA.y_size/2. + iy*DATA.delta_y;
+                double x_local    = - DATA.x_size/2. + arena.ix_input(ix)*DATA.delta_x;
+                double y_local    = - DATA.y_size/2. + arena.iy_input(iy)*DATA.delta_y;
                 double e_local    = arena(ix, iy, ieta).epsilon;  // 1/fm^4
                 double gamma_perp = arena(ix, iy, ieta).u[0];
                 x_o   += x_local*e_local*gamma_perp;
@@ -2205,8 +2251,8 @@ void Cell_info::output_momentum_anisotropy_vs_tau(
             y_o /= w_sum;
             for (int iy = 0; iy < arena.nY(); iy++)
             for (int ix = 0; ix < arena.nX(); ix++) {
-                double x_local   = (- DATA.x_size/2. + ix*DATA.delta_x - x_o);
-                double y_local   = (- DATA.y_size/2. + iy*DATA.delta_y - y_o);
+                double x_local   = (- DATA.x_size/2. + arena.ix_input(ix)*DATA.delta_x - x_o);
+                double y_local   = (- DATA.y_size/2. + arena.iy_input(iy)*DATA.delta_y - y_o);
                 double r_local   = sqrt(x_local*x_local + y_local*y_local);
                 double phi_local = atan2(y_local, x_local);
 
@@ -2313,6 +2359,76 @@ void Cell_info::output_momentum_anisotropy_vs_tau(
             }
         }
     }
+    std::vector<double*> sums = {
+        &ideal_num1, &ideal_num2, &ideal_den, &shear_num1, &shear_num2,
+        &shear_den, &full_num1, &full_num2, &full_den, &u_perp_num,
+        &u_perp_den, &T_avg_num, &T_avg_den, &R_Pi_num, &R_Pi_den,
+        &R_shearpi_num, &R_shearpi_den};
+    for (auto *sum_i : {&ep_num1, &ep_num2, &ep_den, &eccn_num1, &eccn_num2,
+                        &eccn_den, &meanpT_est_num, &meanpT_est_den}) {
+        for (auto &x : *sum_i) sums.push_back(&x);
+    }
+    domain.sum(sums);
+    if (!domain.is_root()) return;
+
+    ostringstream filename;
+    filename << "momentum_anisotropy_eta_" << eta_min
+             << "_" << eta_max << ".dat";
+    std::fstream of;
+    if (std::abs(tau - DATA.tau0) < 1e-10) {
+        of.open(filename.str().c_str(), std::fstream::out);
+        of << "# tau(fm)  epsilon_p(ideal)(cos)  epsilon_p(ideal)(sin)  "
+           << "epsilon_p(shear)(cos)  epsilon_p(shear)(sin)  "
+           << "epsilon_p(full)(cos)  epsilon_p(full)(sin)  "
+           << "epsilon_2p(ideal)(cos)  epsilon_2p(ideal)(sin)  "
+           << "epsilon_2p(shear)(cos)  epsilon_2p(shear)(sin)  "
+           << "epsilon_2p(full)(cos)  epsilon_2p(full)(sin)  "
+           << "epsilon_3p(ideal)(cos)  epsilon_3p(ideal)(sin)  "
+           << "epsilon_3p(shear)(cos)  epsilon_3p(shear)(sin)  "
+           << "epsilon_3p(full)(cos)  epsilon_3p(full)(sin)  "
+           << endl;
+    } else {
+        of.open(filename.str().c_str(),
+                std::fstream::out | std::fstream::app);
+    }
+
+    ostringstream filename1;
+    filename1 << "eccentricities_evo_eta_" << eta_min
+              << "_" << eta_max << ".dat";
+    std::fstream of1;
+    if (std::abs(tau - DATA.tau0) < 1e-10) {
+        of1.open(filename1.str().c_str(), std::fstream::out);
+        of1 << "# tau(fm)  ecc_n(cos)  ecc_n(sin) (n=1-6)"<< endl;
+    } else {
+        of1.open(filename1.str().c_str(),
+                 std::fstream::out | std::fstream::app);
+    }
+
+    ostringstream filename2;
+    filename2 << "inverse_Reynolds_number_eta_" << eta_min
+             << "_" << eta_max << ".dat";
+    std::fstream of2;
+    if (std::abs(tau - DATA.tau0) < 1e-10) {
+        of2.open(filename2.str().c_str(), std::fstream::out);
+        of2 << "# tau(fm)  R_shearpi  R_Pi  gamma  T[GeV]" << endl;
+    } else {
+        of2.open(filename2.str().c_str(),
+                 std::fstream::out | std::fstream::app);
+    }
+
+    ostringstream filename3;
+    filename3 << "meanpT_estimators_eta_" << eta_min << "_" << eta_max
+              << ".dat";
+    std::fstream of3;
+    if (std::abs(tau - DATA.tau0) < 1e-10) {
+        of3.open(filename3.str().c_str(), std::fstream::out);
+        of3 << "# tau (fm)  dS/deta_s  dE/deta_s (GeV) [s] (1/fm^-3)  "
+            << "[r^2] (fm^2)" << endl;
+    } else {
+        of3.open(filename3.str().c_str(),
+                 std::fstream::out | std::fstream::app);
+    }
+
     double R_shearpi = R_shearpi_num/std::max(R_shearpi_den, small_eps);
     double R_Pi      = R_Pi_num/std::max(R_Pi_den, small_eps);
     double u_avg     = u_perp_num/std::max(u_perp_den, small_eps);
@@ -2358,9 +2474,10 @@ void Cell_info::output_momentum_anisotropy_vs_tau(
 }
 
 
-void Cell_info::get_LRF_shear_stress_tensor(const Cell_small &cell,
-                                            const double eta_s,
-                                            ShearVisVecLRF &res) {
+template <class Cell>
+void Cell_infoT<Cell>::get_LRF_shear_stress_tensor(const Cell_small &cell,
+                                                   const double eta_s,
+                                                   ShearVisVecLRF &res) {
     const double cosh_eta = cosh(eta_s);
     const double sinh_eta = sinh(eta_s);
 
@@ -2433,3 +2550,6 @@ void Cell_info::get_LRF_shear_stress_tensor(const Cell_small &cell,
     res[6] = q_LRF[2];
     res[7] = q_LRF[3];
 }
+
+template class Cell_infoT<Cell_small>;
+template class Cell_infoT<Cell_ideal>;
@@ -12,15 +12,21 @@
 #include "eos.h"
 #include "cell.h"
 #include "grid.h"
+#include "eta_domain.h"
 #include "u_derivative.h"
 #include "pretty_ostream.h"
 #include "HydroinfoMUSIC.h"
 
-class Cell_info {
+template <class Cell>
+class Cell_infoT {
  private:
+    typedef GridT<Cell> Grid;
+
     const InitData &DATA;
     const EOS &eos;
-    U_derivative u_derivative_helper;
+    //! the per-step diagnostics below sum over the eta slab of this rank
+    //! and reduce over all ranks; only the root rank writes their files
+    const EtaDomainT<Cell> &domain;
     pretty_ostream music_message;
 
     int deltaf_qmu_coeff_table_length_T;
@@ -46,24 +52,27 @@ class Cell_info {
     TJbVec Pmu_edge_prev, outflow_flux;
 
  public:
-    Cell_info(const InitData &DATA_in, const EOS &eos_ptr_in);
-    ~Cell_info();
+    Cell_infoT(const InitData &DATA_in, const EOS &eos_ptr_in,
+               const EtaDomainT<Cell> &domain_in);
+    ~Cell_infoT();
 
     //! This function outputs a header files for JF and Gojko's EM programs
     void Output_hydro_information_header();
 
     //! This function outputs hydro evolution file in binary format
-    void OutputEvolutionDataXYEta(SCGrid &arena, double tau);
+    void OutputEvolutionDataXYEta(Grid &arena, double tau);
 
     //! This function outputs hydro evolution file in binary format
-    void OutputEvolutionDataXYEta_chun(SCGrid &arena, double tau);
+    void OutputEvolutionDataXYEta_chun(Grid &arena, double tau);
 
     //! This function outputs hydro evolution file in binary format for photon production
-    void OutputEvolutionDataXYEta_photon(SCGrid &arena, double tau);
+    void OutputEvolutionDataXYEta_photon(Grid &arena, double tau);
 
     //! This function outputs hydro evolution file in binary format
+    //! (the derivative fields at tau from fields)
     void OutputEvolutionDataXYEta_vorticity(
-            SCGrid &arena_curr, SCGrid &arena_prev, double tau);
+            Grid &arena_curr, Grid &arena_prev,
+            DerivedFieldSliceT<Cell> &fields, double tau);
 
     void load_deltaf_qmu_coeff_table(std::string filename);
     void load_deltaf_qmu_coeff_table_14mom(std::string filename);
@@ -74,76 +83,86 @@ class Cell_info {
     //! This function computes the inverse Reynolds number for a given fluid
     //! cell at (ix, iy, ieta)
     void calculate_inverse_Reynolds_numbers(
-                        SCGrid &arena_current,
+                        Grid &arena_current,
                         const int ieta, const int ix, const int iy,
                         double &R_pi, double &R_Pi) const;
 
-    void OutputEvolution_Knudsen_Reynoldsnumbers(SCGrid &arena,
+    void OutputEvolution_Knudsen_Reynoldsnumbers(Grid &arena,
                                                  const double tau) const;
 
     //! This function outputs files to check with Gubser flow solution
-    void Gubser_flow_check_file(SCGrid &arena, const double tau);
+    void Gubser_flow_check_file(Grid &arena, const double tau);
 
     //! This function outputs files to cross check with 1+1D simulation
-    void output_1p1D_check_file(SCGrid &arena, const double tau);
+    void output_1p1D_check_file(Grid &arena, const double tau);
 
     //! This function prints to the screen the maximum local energy density,
     //! the maximum temperature in the current grid
     void get_maximum_energy_density(
-        SCGrid &arena, double &e_max, double &nB_max, double &Tmax);
+        Grid &arena, double &e_max, double &nB_max, double &Tmax);
 
     //! This function outputs energy density and n_b for making movies
-    void output_evolution_for_movie(SCGrid &arena, const double tau);
+    void output_evolution_for_movie(Grid &arena, const double tau);
 
     //! This function outputs average T and mu_B as a function of proper tau
     //! within a given space-time rapidity range
     void output_average_phase_diagram_trajectory(
         const double tau, const double eta_min, const double eta_max,
-        SCGrid &arena);
+        Grid &arena);
+
+    //! adds the cells of the rows ieta_begin <= ieta < ieta_end read by
+    //! the vorticity outputs to fields
+    void add_vorticity_cells(Grid &arena_curr, Grid &arena_prev,
+                             DerivedFieldSliceT<Cell> &fields,
+                             const double eta_min, const double eta_max,
+                             const int ieta_begin, const int ieta_end);
 
     //! This function outputs the vorticity tensor at a given tau
     void output_vorticity_distribution(
-        SCGrid &arena_curr, SCGrid &arena_prev, const double tau,
-        const double eta_min, const double eta_max);
+        Grid &arena_curr, Grid &arena_prev, DerivedFieldSliceT<Cell> &fields,
+        const double tau, const double eta_min, const double eta_max);
 
     //! This function outputs the time evolution of the vorticity tensor
     void output_vorticity_time_evolution(
-        SCGrid &arena_curr, SCGrid &arena_prev, const double tau,
-        const double eta_min, const double eta_max);
+        Grid &arena_curr, Grid &arena_prev, DerivedFieldSliceT<Cell> &fields,
+        const double tau, const double eta_min, const double eta_max);
 
     //! This function dumps the energy density and net baryon density
-    void output_energy_density_and_rhob_disitrubtion(SCGrid &arena,
+    void output_energy_density_and_rhob_disitrubtion(Grid &arena,
                                                      std::string filename);
 
     //! This function computes global angular momentum at a give proper time
-    void compute_angular_momentum(SCGrid &arena, SCGrid &arena_prev,
+    void compute_angular_momentum(Grid &arena, Grid &arena_prev,
                                   const double tau,
                                   const double eta_min, const double eta_max);
 
     //! This function checks the total energy and total net baryon number
     //! at a give proper time
-    void check_conservation_law(SCGrid &arena, SCGrid &arena_prev,
-                                const double tau);
+    //! sums T^{tau mu} and N_B over the cells of box (the cells outside
+    //! of it are vacuum)
+    void check_conservation_law(Grid &arena, Grid &arena_prev,
+                                const double tau, const GridBox &box);
 
     //! This function outputs the evolution of hydrodynamic variables at a
     //! give fluid cell
-    void monitor_a_fluid_cell(SCGrid &arena_curr, SCGrid &arena_prev,
+    void monitor_a_fluid_cell(Grid &arena_curr, Grid &arena_prev,
+                              DerivedFieldSliceT<Cell> &fields,
                               const int ix, const int iy, const int ieta,
                               const double tau);
 
     //! This function outputs system's momentum anisotropy as a function of tau
     void output_momentum_anisotropy_vs_tau(
                 const double tau, const double eta_min, const double eta_max,
-                SCGrid &arena) const;
+                Grid &arena) const;
 
     //! This function outputs system's eccentricity and momentum anisotropy
     //! as functions of eta_s
     void output_momentum_anisotropy_vs_etas(const double tau,
-                                            SCGrid &arena) const;
+                                            Grid &arena) const;
 
     //! This function outputs hydro evolution file into memory for JETSCAPE
     void OutputEvolutionDataXYEta_memory(
-            SCGrid &arena, const double tau, HydroinfoMUSIC &hydro_info_ptr);
+            Grid &arena, const double tau, HydroinfoMUSIC &hydro_info_ptr);
 
 
     //! This function computes the pi^{\mu\nu} in the local rest frame
@@ -152,4 +171,6 @@ class Cell_info {
                                      const double eta_s, ShearVisVecLRF &res);
 };
 
+typedef Cell_infoT<Cell_small> Cell_info;
+
 #endif  // SRC_GRID_INFO_H_
@@ -75,6 +75,23 @@ TEST_CASE("check neighbourloop4"){
     CHECK(sum == 15);
 }
 
+TEST_CASE("check neighbourloop without eta") {
+    SCGrid grid(4, 4, 1);
+    SCGrid grid_ghost(4, 4, 1, 2);
+    int directions = 0;
+    int directions_ghost = 0;
+    Neighbourloop(grid, 1, 2, 0, NLAMBDAS {
+        CHECK(direction < 3);
+        directions++;
+    }, 2);
+    Neighbourloop(grid_ghost, 1, 2, 0, NLAMBDAS {
+        CHECK(direction < 3);
+        directions_ghost++;
+    }, 2);
+    CHECK(directions == 2);
+    CHECK(directions_ghost == 2);
+}
+
 TEST_CASE("check dimension"){
     SCGrid grid(1, 2,3);
 
@@ -83,3 +100,267 @@ TEST_CASE("check dimension"){
     CHECK(grid.nEta() == 3);
 }
 
+
+TEST_CASE("check SoA grid copy") {
+    SCGrid grid(4, 3, 2);
+    for (int i = 0; i < grid.size(); i++) {
+        grid(i).epsilon = i;
+        grid(i).rhob    = 2*i;
+        grid(i).u[1]    = 0.1*i;
+        grid(i).Wmunu[13] = 3*i;
+        grid(i).pi_b    = -i;
+    }
+    SCGridSoA grid_soa(grid.nX(), grid.nY(), grid.nEta());
+    grid_soa.copy_from(grid);
+
+    CHECK(grid_soa.size() == grid.size());
+    for (int ieta = 0; ieta < grid.nEta(); ieta++)
+    for (int iy   = 0; iy   < grid.nY();   iy++  )
+    for (int ix   = 0; ix   < grid.nX();   ix++  ) {
+        const auto& cell = grid_soa(ix, iy, ieta);
+        CHECK(cell.epsilon   == grid(ix, iy, ieta).epsilon);
+        CHECK(cell.rhob      == grid(ix, iy, ieta).rhob);
+        CHECK(cell.u[0]      == grid(ix, iy, ieta).u[0]);
+        CHECK(cell.u[1]      == grid(ix, iy, ieta).u[1]);
+        CHECK(cell.Wmunu[13] == grid(ix, iy, ieta).Wmunu[13]);
+        CHECK(cell.pi_b      == grid(ix, iy, ieta).pi_b);
+    }
+}
+
+TEST_CASE("check SoA neighbourloop") {
+    SCGrid grid(5, 1, 1);
+    for (int i = 0; i < 5; i++) {
+        grid(i, 0, 0).epsilon = i + 1;
+    }
+    SCGridSoA grid_soa(5, 1, 1);
+    grid_soa.copy_from(grid);
+    Neighbourloop(grid_soa, 3, 0, 0, NLAMBDAS_VIEW(CellSoAView) {
+        if (direction == 1) {
+            CHECK(p1.epsilon == 5);
+            CHECK(p2.epsilon == 5);
+            CHECK(m1.epsilon == 3);
+            CHECK(m2.epsilon == 2);
+        } else {
+            CHECK(p1.epsilon == c.epsilon);
+            CHECK(p2.epsilon == c.epsilon);
+            CHECK(m1.epsilon == c.epsilon);
+            CHECK(m2.epsilon == c.epsilon);
+        }
+    });
+}
+
+TEST_CASE("check ghost cells") {
+    SCGrid grid(4, 3, 1, 2);
+    for (int i = 0; i < grid.size(); i++) {
+        grid(i).epsilon = i + 1;
+    }
+    grid.fill_ghost_cells();
+
+    CHECK(grid.nGhost() == 2);
+    CHECK(grid(5).epsilon == grid(1, 1, 0).epsilon);
+    for (int iy = -2; iy < grid.nY() + 2; iy++)
+    for (int ix = -2; ix < grid.nX() + 2; ix++) {
+        CHECK(grid.getHalo(ix, iy, 0).epsilon
+              == (&grid(0, 0, 0))[ix*grid.stride(1) + iy*grid.stride(2)].epsilon);
+    }
+}
+
+TEST_CASE("check ghost cell neighbourloop") {
+    SCGrid grid(5, 4, 6);
+    SCGrid grid_ghost(5, 4, 6, 2);
+    for (int i = 0; i < grid.size(); i++) {
+        grid(i).epsilon       = i;
+        grid_ghost(i).epsilon = i;
+    }
+    grid_ghost.fill_ghost_cells();
+
+    for (int ieta = 0; ieta < grid.nEta(); ieta++)
+    for (int iy   = 0; iy   < grid.nY();   iy++  )
+    for (int ix   = 0; ix   < grid.nX();   ix++  ) {
+        double sum       = 0.;
+        double sum_ghost = 0.;
+        Neighbourloop(grid, ix, iy, ieta, NLAMBDAS {
+            sum += direction*(p1.epsilon + 2*p2.epsilon
+                              + 3*m1.epsilon + 4*m2.epsilon);
+        });
+        Neighbourloop(grid_ghost, ix, iy, ieta, NLAMBDAS {
+            sum_ghost += direction*(p1.epsilon + 2*p2.epsilon
+                                    + 3*m1.epsilon + 4*m2.epsilon);
+        });
+        CHECK(sum == sum_ghost);
+    }
+}
+
+TEST_CASE("check ghost cells by eta slabs") {
+    SCGrid grid(4, 3, 6, 2);
+    SCGrid grid_slabs(4, 3, 6, 2);
+    for (int i = 0; i < grid.size(); i++) {
+        grid(i).epsilon       = i + 1;
+        grid_slabs(i).epsilon = i + 1;
+    }
+    grid.fill_ghost_cells();
+    grid_slabs.fill_ghost_cells(-2, 1);
+    grid_slabs.fill_ghost_cells(1, 4);
+    grid_slabs.fill_ghost_cells(4, 8);
+
+    for (int ieta = -2; ieta < grid.nEta() + 2; ieta++)
+    for (int iy   = -2; iy   < grid.nY()   + 2; iy++  )
+    for (int ix   = -2; ix   < grid.nX()   + 2; ix++  ) {
+        const int offset = (ix*grid.stride(1) + iy*grid.stride(2)
+                            + ieta*grid.stride(3));
+        CHECK((&grid_slabs(0, 0, 0))[offset].epsilon
+              == (&grid(0, 0, 0))[offset].epsilon);
+    }
+
+    SCGridSoA grid_soa(grid.nX(), grid.nY(), grid.nEta());
+    grid_soa.copy_from(grid, 2, 4);
+    for (int ieta = 0; ieta < grid.nEta(); ieta++) {
+        const double expected = (
+            (ieta >= 2 && ieta < 4) ? grid(1, 2, ieta).epsilon : 0.);
+        CHECK(grid_soa(1, 2, ieta).epsilon == expected);
+    }
+}
+
+TEST_CASE("check eta rows") {
+    SCGrid grid(4, 3, 6, 2);
+    for (int i = 0; i < grid.size(); i++) {
+        grid(i).epsilon = i + 1;
+    }
+    grid.fill_ghost_cells();
+    CHECK(grid.eta_row_size() == grid.stride(3));
+    for (int ieta = -2; ieta < grid.nEta() + 2; ieta++) {
+        const Cell_small *row = grid.eta_row(ieta);
+        CHECK(row + 2*grid.stride(1) + 2*grid.stride(2)
+              == &grid(0, 0, 0) + ieta*grid.stride(3));
+        CHECK(grid.eta_row(ieta) + grid.eta_row_size()
+              == grid.eta_row(ieta + 1));
+    }
+}
+
+TEST_CASE("check brickloop visits every cell once") {
+    SCGrid grid(7, 5, 3);
+    const std::array<int, 3> brick = {3, 2, 0};
+    Brickloop(grid.nX(), grid.nY(), grid.nEta(), brick,
+              [&](const int ix, const int iy, const int ieta) {
+        grid(ix, iy, ieta).epsilon += 1.;
+    });
+    for (int i = 0; i < grid.size(); i++) {
+        CHECK(grid(i).epsilon == 1.);
+    }
+}
+
+TEST_CASE("check brick shape") {
+    const std::array<int, 3> brick = {0, 8, 2};
+    // enough bricks: the requested shape
+    CHECK(brick_shape(GridBox(261, 261, 1), brick, 1)
+          == std::array<int, 3>{{261, 8, 1}});
+    // 2+1D: rows first, then x
+    CHECK(brick_shape(GridBox(261, 261, 1), brick, 16)
+          == std::array<int, 3>{{261, 4, 1}});
+    CHECK(brick_shape(GridBox(261, 261, 1), brick, 128)
+          == std::array<int, 3>{{131, 1, 1}});
+    // small box: x is not split below 16 cells
+    CHECK(brick_shape(GridBox(20, 2, 1), brick, 64)
+          == std::array<int, 3>{{20, 1, 1}});
+    CHECK(brick_shape(GridBox(20, 2, 3), brick, 64)
+          == std::array<int, 3>{{20, 1, 1}});
+}
+
+TEST_CASE("check ideal grid conversion") {
+    SCGrid grid(4, 3, 2, 2);
+    for (int i = 0; i < grid.size(); i++) {
+        grid(i).epsilon = i + 1;
+        grid(i).Wmunu[0] = 1.;
+    }
+    IdealGrid grid_ideal(grid);
+    CHECK(grid_ideal.nX() == grid.nX());
+    CHECK(grid_ideal.nEta() == grid.nEta());
+    CHECK(grid_ideal.nGhost() == grid.nGhost());
+    for (int i = 0; i < grid.size(); i++) {
+        CHECK(grid_ideal(i).epsilon == grid(i).epsilon);
+    }
+    SCGrid grid2(grid_ideal);
+    CHECK(grid2(3, 2, 1).epsilon == grid(3, 2, 1).epsilon);
+    CHECK(grid2(3, 2, 1).Wmunu[0] == 0.);
+}
+
+TEST_CASE("check active box") {
+    SCGrid grid(10, 8, 1);
+    CHECK(find_active_box(grid, 0.5, 2).size() == 0);
+
+    grid(4, 3, 0).epsilon = 1.;
+    grid(6, 3, 0).epsilon = 1.;
+    const GridBox box = find_active_box(grid, 0.5, 2);
+    CHECK(box.lo == std::array<int, 3>{{2, 1, 0}});
+    CHECK(box.hi == std::array<int, 3>{{9, 6, 1}});
+
+    const std::array<int, 3> brick = {3, 2, 0};
+    Brickloop(box, brick, [&](const int ix, const int iy, const int ieta) {
+        grid(ix, iy, ieta).rhob += 1.;
+    });
+    for (int iy = 0; iy < grid.nY(); iy++)
+    for (int ix = 0; ix < grid.nX(); ix++) {
+        CHECK(grid(ix, iy, 0).rhob == (box.contains(ix, iy, 0) ? 1. : 0.));
+    }
+
+    GridBox box2 = box;
+    box2.extend(GridBox(1, 1, 1));
+    CHECK(box2.lo == std::array<int, 3>{{0, 0, 0}});
+    CHECK(box2.hi == box.hi);
+}
+
+TEST_CASE("check transverse resize") {
+    SCGrid grid(5, 4, 2);
+    for (int i = 0; i < grid.size(); i++) {
+        grid(i).epsilon = i + 1;
+    }
+    SCGrid grid_large = grid.transverse_resized(2, 1);
+    CHECK(grid_large.nX() == 9);
+    CHECK(grid_large.nY() == 6);
+    CHECK(grid_large.nEta() == 2);
+    CHECK(grid_large(3, 2, 1).epsilon == grid(1, 1, 1).epsilon);
+    CHECK(grid_large(0, 0, 0).epsilon == grid(0, 0, 0).epsilon);
+    CHECK(grid_large(8, 5, 1).epsilon == grid(4, 3, 1).epsilon);
+
+    CHECK(grid_large.ix_input(3) == 1);
+    CHECK(grid_large.iy_input(0) == -1);
+
+    SCGrid grid_back = grid_large.transverse_resized(-2, -1);
+    for (int i = 0; i < grid.size(); i++) {
+        CHECK(grid_back(i).epsilon == grid(i).epsilon);
+    }
+    CHECK(grid_back.ix_input(4) == 4);
+    CHECK(grid_back.iy_input(3) == 3);
+
+    SCGrid grid_small = grid.transverse_resized(-1, 0);
+    CHECK(grid_small.ix_input(0) == 1);
+    CHECK(IdealGrid(grid_small).ix_input(0) == 1);
+}
+
+TEST_CASE("check eta row slabs") {
+    SCGrid grid(3, 2, 6);
+    for (int i = 0; i < grid.size(); i++) {
+        grid(i).epsilon = i + 1;
+    }
+    SCGrid slab = grid.eta_rows(2, 5);
+    CHECK(slab.nX() == 3);
+    CHECK(slab.nY() == 2);
+    CHECK(slab.nEta() == 3);
+    CHECK(slab.ieta_input(0) == 2);
+    for (int ieta = 0; ieta < slab.nEta(); ieta++)
+    for (int iy = 0; iy < slab.nY(); iy++)
+    for (int ix = 0; ix < slab.nX(); ix++) {
+        CHECK(slab(ix, iy, ieta).epsilon == grid(ix, iy, ieta + 2).epsilon);
+    }
+
+    // the rows outside of the grid copy the edge rows
+    SCGrid whole = slab.eta_rows(-2, 4);
+    CHECK(whole.nEta() == 6);
+    CHECK(whole.ieta_input(0) == 0);
+    CHECK(whole(1, 1, 0).epsilon == grid(1, 1, 2).epsilon);
+    CHECK(whole(1, 1, 3).epsilon == grid(1, 1, 3).epsilon);
+    CHECK(whole(1, 1, 5).epsilon == grid(1, 1, 4).epsilon);
+
+    CHECK(slab.transverse_resized(1, 1).ieta_input(0) == 2);
+    CHECK(IdealGrid(slab).ieta_input(1) == 3);
+}
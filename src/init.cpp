@@ -161,9 +161,10 @@ void Init::InitArena(SCGrid &arena_prev, SCGrid &arena_current,
     }
 
     // initialize arena
-    arena_prev    = SCGrid(DATA.nx, DATA.ny, DATA.neta);
-    arena_current = SCGrid(DATA.nx, DATA.ny, DATA.neta);
-    arena_future  = SCGrid(DATA.nx, DATA.ny, DATA.neta);
+    const int n_ghost = (DATA.use_ghost_cells == 1) ? 2 : 0;
+    arena_prev    = SCGrid(DATA.nx, DATA.ny, DATA.neta, n_ghost);
+    arena_current = SCGrid(DATA.nx, DATA.ny, DATA.neta, n_ghost);
+    arena_future  = SCGrid(DATA.nx, DATA.ny, DATA.neta, n_ghost);
     music_message.info("Grid allocated.");
 
     InitTJb(arena_prev, arena_current);
@@ -6,6 +6,10 @@
 #include <sys/stat.h>
 #include <iostream>
 
+#ifdef MUSIC_MPI
+    #include <mpi.h>
+#endif
+
 #include "music.h"
 #include "music_logo.h"
 #include "version.h"
@@ -14,6 +18,11 @@
 int main(int argc, char *argv[]) {
     std::string input_file;
     InitData DATA __attribute__ ((aligned (64)));
+    int mpi_rank = 0;
+#ifdef MUSIC_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+#endif
 
     if (argc > 1)
         input_file = *(argv+1);
@@ -30,19 +39,30 @@ int main(int argc, char *argv[]) {
         music_hydro.initialize_hydro();
         music_hydro.run_hydro();
     }
+#ifdef MUSIC_MPI
+    // the surface files of all ranks are complete
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
 
-    if (running_mode == 1 || running_mode == 3 || running_mode == 4
-            || running_mode == 13 || running_mode == 14) {
+    if (mpi_rank == 0 && (running_mode == 1 || running_mode == 3
+            || running_mode == 4 || running_mode == 13
+            || running_mode == 14)) {
         music_hydro.run_Cooper_Frye();
     }
 
-    if (running_mode == 71) {
+    if (mpi_rank == 0 && running_mode == 71) {
         music_hydro.check_eos();
     }
-    if (running_mode == 73) {
+    if (mpi_rank == 0 && running_mode == 72) {
+        music_hydro.benchmark_eos();
+    }
+    if (mpi_rank == 0 && running_mode == 73) {
         music_hydro.output_transport_coefficients();
     }
 
+#ifdef MUSIC_MPI
+    MPI_Finalize();
+#endif
     return(0);
 }  /* main */
 
@@ -37,6 +37,20 @@ class Minmod {
 	  return diffup*std::max(0., std::min(1.,std::min(diffdown/diffup, diffmid/diffup)));
     }/* minmod_dx */
 
+    //! minmod_dx of n cells at once, out[i] = minmod_dx(up1[i], u[i],
+    //! um1[i]); the loop vectorizes over the cells
+    void minmod_dx(const double *up1, const double *u, const double *um1,
+                   double *out, const int n) const {
+        #pragma omp simd
+        for (int i = 0; i < n; i++) {
+            const double diffup   = (up1[i] - u[i])*theta_flux;
+            const double diffdown = (u[i] - um1[i])*theta_flux;
+            const double diffmid  = (up1[i] - um1[i])*0.5;
+            out[i] = (diffup == 0.) ? 0. : diffup*std::max(0., std::min(1.,
+                            std::min(diffdown/diffup, diffmid/diffup)));
+        }
+    }
+
 };
 
 #endif  // SRC_MINMOD_H_
@@ -20,3 +20,20 @@ TEST_CASE("Does Minmod work") {
     test_dx = test.minmod_dx(0.0, 1.9, 2.0);
     CHECK(test_dx == doctest::Approx(-0.18).epsilon(0.0001));
 }
+
+TEST_CASE("Vectorized minmod matches the scalar one") {
+    Minmod test(1.8);
+    // the last four have up1 == u, where the scalar minmod returns early
+    // and the vector one must not pass on the 0/0 of its slope ratios
+    const double up1[9] = {0.0, 2.0, -2.0, 0.0, 0.0, 1.0, 1.0, 1.0, -0.5};
+    const double u[9]   = {1.0, 1.0, -1.0, 0.1, 1.9, 1.0, 1.0, 1.0, -0.5};
+    const double um1[9] = {0.0, 0.0,  0.0, 2.0, 2.0, 3.0, 0.0, 1.0,  2.0};
+    double out[9];
+    test.minmod_dx(up1, u, um1, out, 9);
+    for (int i = 0; i < 9; i++) {
+        CHECK(out[i] == test.minmod_dx(up1[i], u[i], um1[i]));
+    }
+    for (int i = 5; i < 9; i++) {
+        CHECK(out[i] == 0.0);
+    }
+}
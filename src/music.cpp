@@ -25,6 +25,13 @@ MUSIC::MUSIC(std::string input_file) :
     DATA(ReadInParameters::read_in_parameters(input_file)),
     eos(DATA.whichEOS) {
 
+    if (DATA.omp_thread_affinity == 1) {
+        // before any arena is allocated and first touched
+        const int n_pinned = Util::pin_omp_threads();
+        music_message << "pinned " << n_pinned << " OpenMP threads to CPUs";
+        music_message.flush("info");
+    }
+
     mode                   = DATA.mode;
     flag_hydro_run         = 0;
     flag_hydro_initialized = 0;
@@ -95,13 +102,27 @@ void MUSIC::initialize_hydro() {
 
 //! this is a shell function to run hydro
 int MUSIC::run_hydro() {
-    Evolve evolve_local(eos, DATA, hydro_source_terms_ptr);
-
     if (hydro_info_ptr == nullptr && DATA.store_hydro_info_in_memory == 1) {
         hydro_info_ptr = std::make_shared<HydroinfoMUSIC> ();
     }
-    evolve_local.EvolveIt(arena_prev, arena_current, arena_future,
-                          (*hydro_info_ptr));
+    if (DATA.viscosity_flag == 0) {
+        // ideal hydrodynamics runs on the compact cells without W^{mu nu}
+        // and pi_b, which cuts the memory traffic of every stencil sweep
+        IdealGrid ideal_prev(arena_prev);
+        IdealGrid ideal_current(arena_current);
+        IdealGrid ideal_future(arena_future);
+        arena_prev    = SCGrid();
+        arena_current = SCGrid();
+        arena_future  = SCGrid();
+
+        EvolveT<Cell_ideal> evolve_local(eos, DATA, hydro_source_terms_ptr);
+        evolve_local.EvolveIt(ideal_prev, ideal_current, ideal_future,
+                              (*hydro_info_ptr));
+    } else {
+        Evolve evolve_local(eos, DATA, hydro_source_terms_ptr);
+        evolve_local.EvolveIt(arena_prev, arena_current, arena_future,
+                              (*hydro_info_ptr));
+    }
     flag_hydro_run = 1;
     return(0);
 }
@@ -124,6 +145,14 @@ void MUSIC::check_eos() {
     eos.check_eos();
 }
 
+
+//! this is a micro-benchmark of the EoS queries at random (e, rhob)
+void MUSIC::benchmark_eos() {
+    music_message << "benchmark eos ...";
+    music_message.flush("info");
+    eos.benchmark_eos(2000000);
+}
+
 //! this is a test function to output the transport coefficients as
 //! function of T and mu_B
 void MUSIC::output_transport_coefficients() {
@@ -70,6 +70,7 @@ class MUSIC {
 
     //! This function calls routine to check EoS
     void check_eos();
+    void benchmark_eos();
 
     //! this is a test function to output the transport coefficients as
     //! function of T and mu_B
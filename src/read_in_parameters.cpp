@@ -201,6 +201,9 @@ InitData read_in_parameters(std::string input_file) {
     // 4: Resonance decays only.
     // 13: Compute observables from previously-computed thermal spectra
     // 14: Compute observables from post-decay spectra
+    // 71: Output the EoS tables for checks
+    // 72: Time the EoS queries at random (e, rhob)
+    // 73: Output the transport coefficients
     int tempmode = 1;
     tempinput = Util::StringFind4(input_file, "mode");
     if (tempinput != "empty") {
@@ -369,6 +372,34 @@ InitData read_in_parameters(std::string input_file) {
     music_message << " DeltaTau = " << parameter_list.delta_tau << " fm";
     music_message.flush("info");
 
+    // adaptive_time_step:
+    // 1: choose the time step before every step from the CFL condition
+    //    with the largest signal speed on the grid and from the shortest
+    //    shear and bulk relaxation time; Delta_Tau is the first step
+    //    and the evolution output stays on its grid
+    // 0: fixed time step Delta_Tau
+    int tempadaptive_time_step = 0;
+    tempinput = Util::StringFind4(input_file, "adaptive_time_step");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempadaptive_time_step;
+    parameter_list.adaptive_time_step = tempadaptive_time_step;
+
+    // cfl_number:
+    // dtau*(a_x/dx + a_y/dy + a_eta/deta) for the adaptive time step
+    double tempcfl_number = 0.4;
+    tempinput = Util::StringFind4(input_file, "cfl_number");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempcfl_number;
+    parameter_list.cfl_number = tempcfl_number;
+
+    // delta_tau_max:
+    // upper limit of the adaptive time step in [fm]
+    double tempdelta_tau_max = 0.1;
+    tempinput = Util::StringFind4(input_file, "delta_tau_max");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempdelta_tau_max;
+    parameter_list.delta_tau_max = tempdelta_tau_max;
+
     // output_evolution_data:
     // 1: output bulk information at every grid point at every time step
     int tempoutputEvolutionData = 0;
@@ -523,7 +554,8 @@ InitData read_in_parameters(std::string input_file) {
         istringstream(tempinput) >> temppseudofreeze;
     parameter_list.pseudofreeze = temppseudofreeze;
 
-    // Runge_Kutta_order:  must be 1 or 2
+    // Runge_Kutta_order:  must be 1, 2 or 3
+    // 3: three-stage strong-stability-preserving scheme (SSP-RK3)
     int temprk_order = 2;
     tempinput = Util::StringFind4(input_file, "Runge_Kutta_order");
     if (tempinput != "empty")
@@ -537,6 +569,121 @@ InitData read_in_parameters(std::string input_file) {
         istringstream(tempinput) >> tempminmod_theta  ;
     parameter_list.minmod_theta = tempminmod_theta;
 
+    // use_SoA_grid_storage:
+    // stream the stencil kernels from a structure-of-arrays copy
+    // of the current arena
+    int tempuse_SoA_grid_storage = 0;
+    tempinput = Util::StringFind4(input_file, "use_SoA_grid_storage");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempuse_SoA_grid_storage;
+    parameter_list.use_SoA_grid_storage = tempuse_SoA_grid_storage;
+
+    // use_pencil_flux_kernel:
+    // compute the KT fluxes for whole x-pencils at a time, with the
+    // minmod slopes vectorized along the pencil (same results as 0)
+    int tempuse_pencil_flux_kernel = 0;
+    tempinput = Util::StringFind4(input_file, "use_pencil_flux_kernel");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempuse_pencil_flux_kernel;
+    parameter_list.use_pencil_flux_kernel = tempuse_pencil_flux_kernel;
+
+    // use_face_flux_kernel:
+    // compute each KT interface flux once, store it per face and take the
+    // differences per cell (the neighbouring cells of the cell-by-cell
+    // kernels recompute every face; takes precedence over the pencils)
+    int tempuse_face_flux_kernel = 0;
+    tempinput = Util::StringFind4(input_file, "use_face_flux_kernel");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempuse_face_flux_kernel;
+    parameter_list.use_face_flux_kernel = tempuse_face_flux_kernel;
+
+    // use_primitive_cache:
+    // fill a scratch grid with p, T, cs2, muB, s and tau*T^{tau mu} of
+    // every cell at the beginning of each RK stage, so the stencils do not
+    // call the EOS for every neighbour and component
+    int tempuse_primitive_cache = 0;
+    tempinput = Util::StringFind4(input_file, "use_primitive_cache");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempuse_primitive_cache;
+    parameter_list.use_primitive_cache = tempuse_primitive_cache;
+
+    // omp_thread_affinity:
+    // bind every OpenMP thread to one CPU before the arenas are allocated
+    // (same effect as OMP_PROC_BIND=close OMP_PLACES=threads)
+    int tempomp_thread_affinity = 0;
+    tempinput = Util::StringFind4(input_file, "omp_thread_affinity");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempomp_thread_affinity;
+    parameter_list.omp_thread_affinity = tempomp_thread_affinity;
+
+    // use_ghost_cells:
+    // pad the arenas with a 2-cell ghost layer that is refilled
+    // (outflow boundary) at the beginning of every RK stage
+    int tempuse_ghost_cells = 0;
+    tempinput = Util::StringFind4(input_file, "use_ghost_cells");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempuse_ghost_cells;
+    parameter_list.use_ghost_cells = tempuse_ghost_cells;
+
+    // brick_size_x, brick_size_y, brick_size_eta:
+    // the RK sweep runs over bricks of this many cells
+    // (<= 0 means the whole grid in that direction); they are split
+    // further while there are fewer than 4 bricks per OpenMP thread
+    int tempbrick_size_x = 0;
+    tempinput = Util::StringFind4(input_file, "brick_size_x");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempbrick_size_x;
+    parameter_list.brick_size_x = tempbrick_size_x;
+
+    int tempbrick_size_y = 8;
+    tempinput = Util::StringFind4(input_file, "brick_size_y");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempbrick_size_y;
+    parameter_list.brick_size_y = tempbrick_size_y;
+
+    int tempbrick_size_eta = 2;
+    tempinput = Util::StringFind4(input_file, "brick_size_eta");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempbrick_size_eta;
+    parameter_list.brick_size_eta = tempbrick_size_eta;
+
+    // active_region_eps_cut:
+    // only the bounding box of the cells above this energy density
+    // [GeV/fm^3] (widened by the stencil reach of one time step) is
+    // evolved and scanned for freeze-out; 0 sweeps the whole grid
+    double tempactive_region_eps_cut = 0.;
+    tempinput = Util::StringFind4(input_file, "active_region_eps_cut");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempactive_region_eps_cut;
+    parameter_list.active_region_eps_cut = tempactive_region_eps_cut;
+
+    // expanding_grid:
+    // after the hydro sources are deposited, crop to the smallest
+    // transverse grid that holds the fireball and enlarge it (keeping
+    // delta_x, delta_y) as the fireball grows, up to
+    // Grid_size_in_x * Grid_size_in_y
+    int tempexpanding_grid = 0;
+    tempinput = Util::StringFind4(input_file, "expanding_grid");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempexpanding_grid;
+    parameter_list.expanding_grid = tempexpanding_grid;
+
+    // expanding_grid_eps_cut: energy density [GeV/fm^3] defining the edge
+    // of the fireball
+    double tempexpanding_grid_eps_cut = 1e-3;
+    tempinput = Util::StringFind4(input_file, "expanding_grid_eps_cut");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempexpanding_grid_eps_cut;
+    parameter_list.expanding_grid_eps_cut = tempexpanding_grid_eps_cut;
+
+    // expanding_grid_buffer: minimum number of cells between the fireball
+    // and the grid edge; also the number of cells added per enlargement
+    int tempexpanding_grid_buffer = 10;
+    tempinput = Util::StringFind4(input_file, "expanding_grid_buffer");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempexpanding_grid_buffer;
+    parameter_list.expanding_grid_buffer = tempexpanding_grid_buffer;
+
     // Viscosity_Flag_Yes_1_No_0:   set to 0 for ideal hydro
     int tempviscosity_flag = 1;
     tempinput = Util::StringFind4(input_file, "Viscosity_Flag_Yes_1_No_0");
@@ -750,6 +897,19 @@ InitData read_in_parameters(std::string input_file) {
         istringstream(tempinput) >> tempturn_on_vorticity_terms;
     parameter_list.include_vorticity_terms = tempturn_on_vorticity_terms;
 
+    // semi_implicit_relaxation:
+    // 1: the relaxation terms -W/tau_pi, -Pi/tau_Pi and -q/tau_q of the
+    //    viscous source terms are taken at the end of every RK stage
+    //    (backward Euler), which is stable for any relaxation time, so the
+    //    relaxation times are no longer raised to 3 Delta_Tau and the
+    //    adaptive time step only follows the CFL condition
+    // 0: explicit source terms
+    int tempsemi_implicit_relaxation = 0;
+    tempinput = Util::StringFind4(input_file, "semi_implicit_relaxation");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> tempsemi_implicit_relaxation;
+    parameter_list.semi_implicit_relaxation = tempsemi_implicit_relaxation;
+
     // Output vorticity evolution
     int tempoutput_vorticity = 0;
     tempinput = Util::StringFind4(input_file, "output_vorticity");
@@ -1169,6 +1329,16 @@ void check_parameters(InitData &parameter_list, std::string input_file) {
         music_message.flush("warning");
     }
 
+    if (parameter_list.expanding_grid == 1
+        && (   parameter_list.outputEvolutionData != 0
+            || parameter_list.output_movie_flag != 0
+            || parameter_list.store_hydro_info_in_memory != 0)) {
+        music_message << "expanding_grid needs a fixed grid for the "
+                      << "evolution output. Reset expanding_grid to 0.";
+        music_message.flush("warning");
+        parameter_list.expanding_grid = 0;
+    }
+
     if (parameter_list.neta < 2 && !parameter_list.boost_invariant) {
         music_message << "Grid size in eta = " << parameter_list.neta 
                       << "is too small for a (3+1)-d run! "
@@ -1229,6 +1399,21 @@ void check_parameters(InitData &parameter_list, std::string input_file) {
             exit(1);
         }
     }
+    parameter_list.delta_tau_prev   = parameter_list.delta_tau;
+    parameter_list.delta_tau_output = (
+        parameter_list.output_evolution_every_N_timesteps
+        *parameter_list.delta_tau);
+
+    if (parameter_list.adaptive_time_step == 1
+        && (parameter_list.cfl_number <= 0. || parameter_list.cfl_number > 1.
+            || parameter_list.delta_tau_max <= 0.)) {
+        music_message << "adaptive_time_step needs 0 < cfl_number <= 1 "
+                      << "and delta_tau_max > 0: cfl_number = "
+                      << parameter_list.cfl_number << ", delta_tau_max = "
+                      << parameter_list.delta_tau_max;
+        music_message.flush("error");
+        exit(1);
+    }
 
     if (parameter_list.min_pt > parameter_list.max_pt) {
         music_message << "min_pt = " << parameter_list.min_pt << " > "
@@ -1245,7 +1430,7 @@ void check_parameters(InitData &parameter_list, std::string input_file) {
         exit(1);
     }
 
-    if (parameter_list.rk_order > 2 || parameter_list.rk_order < 0) {
+    if (parameter_list.rk_order > 3 || parameter_list.rk_order < 1) {
         music_message << "Invalid option for Runge_Kutta_order: "
                       << parameter_list.rk_order;
         music_message.flush("error");
@@ -1350,6 +1535,43 @@ void check_parameters(InitData &parameter_list, std::string input_file) {
         exit(1);
     }
 
+    // the cells outside the active box are not evolved, so the box has to
+    // contain every cell that can still cross a freeze-out surface
+    if (parameter_list.active_region_eps_cut < 0.) {
+        music_message << "active_region_eps_cut = "
+                      << parameter_list.active_region_eps_cut << " < 0!";
+        music_message.flush("error");
+        exit(1);
+    }
+    if (parameter_list.freezeOutMethod == 4
+            && parameter_list.freeze_eps_flag == 0
+            && parameter_list.active_region_eps_cut > 0.
+            && parameter_list.active_region_eps_cut
+               >= parameter_list.eps_freeze_min) {
+        music_message << "active_region_eps_cut = "
+                      << parameter_list.active_region_eps_cut
+                      << " GeV/fm^3 is not below the lowest freeze-out "
+                      << "energy density eps_freeze_min = "
+                      << parameter_list.eps_freeze_min << " GeV/fm^3";
+        music_message.flush("error");
+        exit(1);
+    }
+    // the same for the edge of the fireball the expanding grid is cropped
+    // to
+    if (parameter_list.freezeOutMethod == 4
+            && parameter_list.freeze_eps_flag == 0
+            && parameter_list.expanding_grid == 1
+            && parameter_list.expanding_grid_eps_cut
+               >= parameter_list.eps_freeze_min) {
+        music_message << "expanding_grid_eps_cut = "
+                      << parameter_list.expanding_grid_eps_cut
+                      << " GeV/fm^3 is not below the lowest freeze-out "
+                      << "energy density eps_freeze_min = "
+                      << parameter_list.eps_freeze_min << " GeV/fm^3";
+        music_message.flush("error");
+        exit(1);
+    }
+
     music_message << "Finished checking input parameter list. "
                   << "Everything looks reasonable so far "
                   << emoji::success() << emoji::thumbup()
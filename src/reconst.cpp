@@ -19,7 +19,7 @@ Reconst::Reconst(const EOS &eosIn, const int echo_level_in) :
 
 
 ReconstCell Reconst::ReconstIt_shell(double tau, const TJbVec &tauq_vec,
-                                     const Cell_small &grid_pt) {
+                                     const ReconstCell &grid_pt) {
     ReconstCell grid_p1;
 
     TJbVec q_vec;
@@ -42,8 +42,8 @@ ReconstCell Reconst::ReconstIt_shell(double tau, const TJbVec &tauq_vec,
 //! This function reverts the grid information back its values
 //! at the previous time step
 void Reconst::revert_grid(ReconstCell &grid_current,
-                          const Cell_small &grid_prev) const {
-    grid_current.e    = grid_prev.epsilon;
+                          const ReconstCell &grid_prev) const {
+    grid_current.e    = grid_prev.e;
     grid_current.rhob = grid_prev.rhob;
     grid_current.u    = grid_prev.u;
 }
@@ -53,7 +53,7 @@ void Reconst::revert_grid(ReconstCell &grid_current,
 //! use Newton's method to solve v and u0
 int Reconst::ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
                                        const TJbVec &q,
-                                       const Cell_small &grid_pt) {
+                                       const ReconstCell &grid_pt) {
     double K00 = q[1]*q[1] + q[2]*q[2] + q[3]*q[3];
     double M   = sqrt(K00);
     double T00 = q[0];
@@ -106,12 +106,12 @@ int Reconst::ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
 
     double check_u0_var = std::abs(u[0] - grid_pt.u[0])/grid_pt.u[0];
     if (check_u0_var > 100.) {
-        if (grid_pt.epsilon > 1e-6 && echo_level > 2) {
+        if (grid_pt.e > 1e-6 && echo_level > 2) {
             music_message << "Reconst velocity Newton:: "
                           << "u0 varies more than 100 times compared to "
                           << "its value at previous time step";
             music_message.flush("warning");
-            music_message << "e = " << grid_pt.epsilon
+            music_message << "e = " << grid_pt.e
                           << ", u[0] = " << u[0]
                           << ", prev_u[0] = " << grid_pt.u[0];
             music_message.flush("warning");
@@ -30,7 +30,18 @@ class Reconst {
     Reconst(const EOS &eos, const int echo_level_in);
 
     ReconstCell ReconstIt_shell(double tau, const TJbVec &tauq_vec,
-                                const Cell_small &grid_pt);
+                                const ReconstCell &grid_pt);
+
+    //! accepts any cell with the Cell_small member surface (Cell_small,
+    //! CellSoAView) as the initial guess
+    template <class CellType>
+    ReconstCell ReconstIt_shell(double tau, const TJbVec &tauq_vec,
+                                const CellType &grid_pt) {
+        const ReconstCell guess = {grid_pt.epsilon, grid_pt.rhob,
+                                   {grid_pt.u[0], grid_pt.u[1],
+                                    grid_pt.u[2], grid_pt.u[3]}};
+        return ReconstIt_shell(tau, tauq_vec, guess);
+    }
 
     int get_max_iter() const {return(max_iter);}
     int get_echo_level() const {return(echo_level);}
@@ -38,10 +49,10 @@ class Reconst {
     double get_v_critical() const {return(v_critical);}
 
     void revert_grid(ReconstCell &grid_current,
-                     const Cell_small &grid_prev) const;
+                     const ReconstCell &grid_prev) const;
 
     int ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
-                                  const TJbVec &q, const Cell_small &grid_pt);
+                                  const TJbVec &q, const ReconstCell &grid_pt);
     
     void reconst_velocity_fdf(const double v, const double T00, const double M,
                               const double J0, double &fv, double &dfdv) const;
@@ -1,3 +1,10 @@
+#ifdef _OPENMP
+    #include <omp.h>
+#else
+    #define omp_get_thread_num() 0
+    #define omp_get_max_threads() 1
+#endif
+
 #include "util.h"
 #include "data.h"
 #include "cell.h"
@@ -6,7 +13,8 @@
 #include "eos.h"
 #include "u_derivative.h"
 
-U_derivative::U_derivative(const InitData &DATA_in, const EOS &eosIn) :
+template <class Cell>
+U_derivativeT<Cell>::U_derivativeT(const InitData &DATA_in, const EOS &eosIn) :
     DATA(DATA_in),
     eos(eosIn),
     minmod(DATA_in) {
@@ -16,23 +24,78 @@ U_derivative::U_derivative(const InitData &DATA_in, const EOS &eosIn) :
 }
 
 //! This function is a shell function to calculate parital^\nu u^\mu
-void U_derivative::MakedU(const double tau, SCGrid &arena_prev,
-                          SCGrid &arena_current,
-                          const int ix, const int iy, const int ieta) {
-    dUsup = {0.0};
-    dUoverTsup = {0.0};
-    dUTsup = {0.0};
+template <class Cell>
+void U_derivativeT<Cell>::MakedU(const double tau, const double dtau,
+                                 Grid &arena_prev, Grid &arena_current,
+                                 const int ix, const int iy, const int ieta) {
+    // MakeDSpatial and MakeDTau overwrite every entry of dUsup, and of
+    // dUoverTsup and dUTsup if include_vorticity_terms == 1 (they stay
+    // zero otherwise), so there is nothing to reset here
 
     // this calculates du/dx, du/dy, (du/deta)/tau
     MakeDSpatial(tau, arena_current, ix, iy, ieta);
     // this calculates du/dtau
-    MakeDTau(tau, &arena_prev(ix, iy, ieta), &arena_current(ix, iy, ieta));
+    MakeDTau(tau, dtau, &arena_prev(ix, iy, ieta),
+             &arena_current(ix, iy, ieta));
+}
+
+
+template <class Cell>
+void U_derivativeT<Cell>::compute_viscous_gradients(
+        const double tau, Grid &arena_prev, Grid &arena_current,
+        const int ix, const int iy, const int ieta, ViscousGradients &grad) {
+    MakedU(tau, DATA.delta_tau_prev, arena_prev, arena_current, ix, iy, ieta);
+    viscous_gradients_from_dU(tau, arena_current, ix, iy, ieta, grad);
+}
+
+
+template <class Cell>
+void U_derivativeT<Cell>::viscous_gradients_from_dU(
+        const double tau, Grid &arena_current,
+        const int ix, const int iy, const int ieta, ViscousGradients &grad) {
+    grad.theta = calculate_expansion_rate(tau, arena_current, ieta, ix, iy);
+    calculate_Du_supmu(tau, arena_current, ieta, ix, iy, grad.a);
+    calculate_velocity_shear_tensor(tau, arena_current, ieta, ix, iy,
+                                    grad.a, grad.sigma);
+    calculate_kinetic_vorticity_with_spatial_projector(
+            tau, arena_current, ieta, ix, iy, grad.a, grad.omega);
+    get_DmuMuBoverTVec(grad.DmuMuBoverT);
+}
+
+
+template <class Cell>
+void U_derivativeT<Cell>::compute_derived_fields(
+        const double tau, const double dtau,
+        Grid &arena_prev, Grid &arena_current,
+        const int ix, const int iy, const int ieta, DerivedFields &fields) {
+    MakedU(tau, dtau, arena_prev, arena_current, ix, iy, ieta);
+    viscous_gradients_from_dU(tau, arena_current, ix, iy, ieta, fields.grad);
+    calculate_kinetic_vorticity_no_spatial_projection(
+            tau, arena_current, ieta, ix, iy, fields.omega_k);
+    calculate_thermal_vorticity(tau, arena_current, ieta, ix, iy,
+                                fields.omega_th);
+    calculate_T_vorticity(tau, arena_current, ieta, ix, iy, fields.omega_T);
+}
+
+
+template <class Cell>
+Cell_aux U_derivativeT<Cell>::derived_fields_to_tz(
+        const DerivedFields &fields, const double eta) {
+    Cell_aux aux;
+    aux.omega_kSP = transform_vorticity_to_tz(fields.grad.omega, eta);
+    aux.omega_k   = transform_vorticity_to_tz(fields.omega_k, eta);
+    aux.omega_th  = transform_vorticity_to_tz(fields.omega_th, eta);
+    aux.omega_T   = transform_vorticity_to_tz(fields.omega_T, eta);
+    aux.sigma     = transform_SigmaMuNu_to_tz(fields.grad.sigma, eta);
+    aux.DbetaMu   = transform_vector_to_tz(fields.grad.DmuMuBoverT, eta);
+    return(aux);
 }
 
 
 //! this function returns the expansion rate on the grid
-double U_derivative::calculate_expansion_rate(
-        double tau, SCGrid &arena, int ieta, int ix, int iy) {
+template <class Cell>
+double U_derivativeT<Cell>::calculate_expansion_rate(
+        double tau, Grid &arena, int ieta, int ix, int iy) {
     double partial_mu_u_supmu = 0.0;
     for (int mu = 0; mu < 4; mu++) {
         double gfac = (mu == 0 ? -1.0 : 1.0);
@@ -45,9 +108,10 @@ double U_derivative::calculate_expansion_rate(
 
 
 //! this function returns Du^\mu
-void U_derivative::calculate_Du_supmu(const double tau, SCGrid &arena,
-                                      const int ieta, const int ix,
-                                      const int iy, DumuVec &a) {
+template <class Cell>
+void U_derivativeT<Cell>::calculate_Du_supmu(const double tau, Grid &arena,
+                                             const int ieta, const int ix,
+                                             const int iy, DumuVec &a) {
     for (int mu = 0; mu <= 4; mu++) {
         double u_supnu_partial_nu_u_supmu = 0.0;
         for (int nu = 0; nu < 4; nu++) {
@@ -61,13 +125,14 @@ void U_derivative::calculate_Du_supmu(const double tau, SCGrid &arena,
 
 
 // This is a shell function to compute all 4 kinds of vorticity tensors
-void U_derivative::compute_vorticity_shell(
-        const double tau, SCGrid &arena_prev, SCGrid &arena_curr,
-        const int ieta, const int ix, const int iy, const double eta,
-        VorticityVec &omega_local_kSP, VorticityVec &omega_local_knoSP,
+template <class Cell>
+void U_derivativeT<Cell>::compute_vorticity_shell(
+        const double tau, const double dtau, Grid &arena_prev,
+        Grid &arena_curr, const int ieta, const int ix, const int iy,
+        const double eta, VorticityVec &omega_local_kSP, VorticityVec &omega_local_knoSP,
         VorticityVec &omega_local_th, VorticityVec &omega_local_T,
         VelocityShearVec &sigma_local, DmuMuBoverTVec &DbetaMu) {
-    MakedU(tau, arena_prev, arena_curr, ix, iy, ieta);
+    MakedU(tau, dtau, arena_prev, arena_curr, ix, iy, ieta);
     DumuVec a_local;
     calculate_Du_supmu(tau, arena_curr, ieta, ix, iy, a_local);
 
@@ -98,7 +163,8 @@ void U_derivative::compute_vorticity_shell(
 //             sigma^xx, sigma^xy, sigma^xz,
 //             sigma^yy, sigma^yz,
 //             sigma^zz)
-VelocityShearVec U_derivative::transform_SigmaMuNu_to_tz(
+template <class Cell>
+VelocityShearVec U_derivativeT<Cell>::transform_SigmaMuNu_to_tz(
                     const VelocityShearVec sigma_Mline, const double eta) {
     VelocityShearVec sigma_Cart;
     const double cosh_eta = cosh(eta);
@@ -125,7 +191,8 @@ VelocityShearVec U_derivative::transform_SigmaMuNu_to_tz(
 
 // This function transforms the vorticity tensor from tau-eta to tz
 // It outputs (omega^tx, omega^ty, omega^tz, omega^xy, omega^xz, omega^yz)
-VorticityVec U_derivative::transform_vorticity_to_tz(
+template <class Cell>
+VorticityVec U_derivativeT<Cell>::transform_vorticity_to_tz(
                     const VorticityVec omega_Mline, const double eta) {
     VorticityVec omega_Cart;
     const double cosh_eta = cosh(eta);
@@ -142,7 +209,8 @@ VorticityVec U_derivative::transform_vorticity_to_tz(
 
 // This function transforms the vorticity tensor from tau-eta to tz
 // It outputs (vec^t, vec^x, vec^y, vec^z)
-DmuMuBoverTVec U_derivative::transform_vector_to_tz(
+template <class Cell>
+DmuMuBoverTVec U_derivativeT<Cell>::transform_vector_to_tz(
                     const DmuMuBoverTVec vec_Mline, const double eta) {
     DmuMuBoverTVec vec_Cart;
     const double cosh_eta = cosh(eta);
@@ -162,8 +230,9 @@ DmuMuBoverTVec U_derivative::transform_vector_to_tz(
 //! conventional kinetic vorticity in the literature
 //! Because MUSIC use the metric g = (-1, 1, 1, 1), the output omega^{\mu\nu}
 //! differs from the ones with g = (1, -1, -1, -1) by a minus sign
-void U_derivative::calculate_kinetic_vorticity_with_spatial_projector(
-            const double tau, SCGrid &arena,
+template <class Cell>
+void U_derivativeT<Cell>::calculate_kinetic_vorticity_with_spatial_projector(
+            const double tau, Grid &arena,
             const int ieta, const int ix, const int iy,
             const DumuVec &a_local, VorticityVec &omega) {
     FlowVec u_local = arena(ix, iy, ieta).u;
@@ -218,8 +287,9 @@ void U_derivative::calculate_kinetic_vorticity_with_spatial_projector(
 //! this function computes the thermal vorticity
 //! it outputs omega^{\mu\nu} in the metric g = (-1, 1, 1, 1) which differs
 //! from the ones with g = (1, -1, -1, -1) by a minus sign
-void U_derivative::calculate_thermal_vorticity(
-            const double tau, SCGrid &arena, const int ieta,
+template <class Cell>
+void U_derivativeT<Cell>::calculate_thermal_vorticity(
+            const double tau, Grid &arena, const int ieta,
             const int ix, const int iy, VorticityVec &omega) {
     // this function computes the thermal vorticity
     FlowVec u_local = arena(ix, iy, ieta).u;
@@ -265,8 +335,9 @@ void U_derivative::calculate_thermal_vorticity(
 //! this function computes the temperature- (T-)vorticity
 //! it outputs omega^{\mu\nu} in the metric g = (-1, 1, 1, 1) which differs
 //! from the ones with g = (1, -1, -1, -1) by a minus sign
-void U_derivative::calculate_T_vorticity(
-            const double tau, SCGrid &arena, const int ieta,
+template <class Cell>
+void U_derivativeT<Cell>::calculate_T_vorticity(
+            const double tau, Grid &arena, const int ieta,
             const int ix, const int iy, VorticityVec &omega) {
     // this function computes the T-vorticity
     FlowVec u_local = arena(ix, iy, ieta).u;
@@ -303,8 +374,9 @@ void U_derivative::calculate_T_vorticity(
 //! this function computes the conventional kinetic vorticity
 //! it outputs omega^{\mu\nu} in the metric g = (-1, 1, 1, 1) which differs
 //! from the ones with g = (1, -1, -1, -1) by a minus sign
-void U_derivative::calculate_kinetic_vorticity_no_spatial_projection(
-            const double tau, SCGrid &arena, const int ieta,
+template <class Cell>
+void U_derivativeT<Cell>::calculate_kinetic_vorticity_no_spatial_projection(
+            const double tau, Grid &arena, const int ieta,
             const int ix, const int iy, VorticityVec &omega) {
     // this function computes the full kinetic vorticity without the spatial
     // projection
@@ -342,8 +414,9 @@ void U_derivative::calculate_kinetic_vorticity_no_spatial_projection(
 //! it outputs sigma^{\mu\nu} in the metric g = (-1, 1, 1, 1)
 //! Please note that this output differs from the sigma^{\mu\nu} in the metric
 //! g = (1, -1, -1, -1) by a minus sign
-void U_derivative::calculate_velocity_shear_tensor(
-        const double tau, SCGrid &arena, const int ieta, const int ix,
+template <class Cell>
+void U_derivativeT<Cell>::calculate_velocity_shear_tensor(
+        const double tau, Grid &arena, const int ieta, const int ix,
         const int iy, const DumuVec &a_local, VelocityShearVec &sigma) {
     FlowVec u_local = arena(ix, iy, ieta).u;
     double dUsup_local[4][4];
@@ -407,20 +480,35 @@ void U_derivative::calculate_velocity_shear_tensor(
 }
 
 //! this function returns the vector D^\mu(\mu_B/T)
-void U_derivative::get_DmuMuBoverTVec(DmuMuBoverTVec &vec) {
+template <class Cell>
+void U_derivativeT<Cell>::get_DmuMuBoverTVec(DmuMuBoverTVec &vec) {
     for (int mu = 0; mu < 4; mu++)
         vec[mu] = dUsup[4][mu];
 }
 
 
-int U_derivative::MakeDSpatial(const double tau, SCGrid &arena,
-                               const int ix, const int iy, const int ieta) {
+template <class Cell>
+int U_derivativeT<Cell>::MakeDSpatial(const double tau, Grid &arena,
+                                      const int ix, const int iy, const int ieta) {
     // taken care of the tau factor
     const double delta[4] = {0.0, DATA.delta_x, DATA.delta_y,
                              DATA.delta_eta*tau};
 
+    // a boost-invariant grid has no eta neighbours and all eta
+    // derivatives vanish
+    const int n_direc = DATA.boost_invariant ? 2 : 3;
+    if (DATA.boost_invariant) {
+        for (int m = 0; m < 5; m++) {
+            dUsup[m][3] = 0.;
+        }
+        for (int m = 0; m < 4; m++) {
+            dUoverTsup[m][3] = 0.;
+            dUTsup[m][3] = 0.;
+        }
+    }
+
     // calculate dUsup[m][n] = partial^n u^m
-    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
+    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS_VIEW(Cell){
         for (int m = 1; m <= 3; m++) {
             const double f   = c.u[m];
             const double fp1 = p1.u[m];
@@ -448,7 +536,7 @@ int U_derivative::MakeDSpatial(const double tau, SCGrid &arena,
                     minmod.minmod_dx(fp1*Tp1, f*T, fm1*Tm1)/delta[direction]);
             }
         }
-    });
+    }, n_direc);
 
     /* for u[0], use u[0]u[0] = 1 + u[i]u[i] */
     /* u[0]_m = u[i]_m (u[i]/u[0]) */
@@ -473,19 +561,20 @@ int U_derivative::MakeDSpatial(const double tau, SCGrid &arena,
     const double muB = eos.get_muB(eps, rhob);
     const double T = eos.get_temperature(eps, rhob);
     const double f = muB/T;
-    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
+    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS_VIEW(Cell){
         const double fp1 = (eos.get_muB(p1.epsilon, p1.rhob)
                             /eos.get_temperature(p1.epsilon, p1.rhob));
         const double fm1 = (eos.get_muB(m1.epsilon, m1.rhob)
                             /eos.get_temperature(m1.epsilon, m1.rhob));
         dUsup[m][direction] = minmod.minmod_dx(fp1, f, fm1)/delta[direction];
-    });
+    }, n_direc);
     return 1;
 }/* MakeDSpatial */
 
-int U_derivative::MakeDTau(const double tau,
-                           const Cell_small *grid_pt_prev,
-                           const Cell_small *grid_pt) {
+template <class Cell>
+int U_derivativeT<Cell>::MakeDTau(const double tau, const double dtau,
+                                  const Cell *grid_pt_prev,
+                                  const Cell *grid_pt) {
     /* this makes dU[m][0] = partial^tau u^m */
     /* note the minus sign at the end because of g[0][0] = -1 */
 
@@ -498,20 +587,20 @@ int U_derivative::MakeDTau(const double tau,
 
     for (int m = 0; m < 4; m++) {
         // first order is more stable
-        double f = (grid_pt->u[m] - grid_pt_prev->u[m])/DATA.delta_tau;
+        double f = (grid_pt->u[m] - grid_pt_prev->u[m])/dtau;
         dUsup[m][0] = -f;  // g^{00} = -1
 
         if (DATA.include_vorticity_terms == 1) {
             if (T > T_tol && T_prev > T_tol) {
                 double duoverTdtau = (
                     (grid_pt->u[m]/T - grid_pt_prev->u[m]/T_prev)
-                    /DATA.delta_tau);
+                    /dtau);
                 dUoverTsup[m][0] = -duoverTdtau;   // g^{00} = -1
             } else {
                 dUoverTsup[m][0] = 0.;
             }
             double duTdtau = ((grid_pt->u[m]*T - grid_pt_prev->u[m]*T_prev)
-                              /DATA.delta_tau);
+                              /dtau);
             dUTsup[m][0] = -duTdtau;   // g^{00} = -1
         }
     }
@@ -534,9 +623,79 @@ int U_derivative::MakeDTau(const double tau,
     // first order is more stable backward derivative
     const double muB = eos.get_muB(eps, rhob);
     const double tildemu = muB/T;
-    const double muB_prev = eos.get_muB(eps, rhob);
+    const double muB_prev = eos.get_muB(eps_prev, rhob_prev);
     const double tildemu_prev = muB_prev/T_prev;
-    f = (tildemu - tildemu_prev)/(DATA.delta_tau);
+    f = (tildemu - tildemu_prev)/dtau;
     dUsup[m][0]  = -f;  // g^{00} = -1
     return 1;
 }
+
+template <class Cell>
+U_derivative_poolT<Cell>::U_derivative_poolT(const InitData &DATA_in,
+                                             const EOS &eosIn) {
+    const int n_threads = omp_get_max_threads();
+    helpers.resize(n_threads);
+    #pragma omp parallel
+    {
+        const int thread_id = omp_get_thread_num();
+        if (thread_id < n_threads) {
+            helpers[thread_id].reset(
+                        new U_derivativeT<Cell>(DATA_in, eosIn));
+        }
+    }
+    for (auto &helper : helpers) {
+        if (!helper) helper.reset(new U_derivativeT<Cell>(DATA_in, eosIn));
+    }
+}
+
+template <class Cell>
+U_derivativeT<Cell>& U_derivative_poolT<Cell>::local() {
+    return(*helpers[omp_get_thread_num()]);
+}
+
+template <class Cell>
+void DerivedFieldSliceT<Cell>::reset(const int nx, const int ny,
+                                     const int neta, const double tau) {
+    if (nx != nx_ || ny != ny_ || neta != neta_) {
+        nx_   = nx;
+        ny_   = ny;
+        neta_ = neta;
+        index_.assign(nx*ny*neta, -1);
+    } else {
+        for (const int idx : cells_) index_[idx] = -1;
+    }
+    cells_.clear();
+    fields_.clear();
+    tau_ = tau;
+}
+
+template <class Cell>
+void DerivedFieldSliceT<Cell>::add(const double dtau, Grid &arena_prev,
+                                   Grid &arena_current,
+                                   const std::vector<int> &cells) {
+    const int n_old = size();
+    for (const int idx : cells) {
+        if (index_[idx] >= 0) continue;
+        index_[idx] = static_cast<int>(cells_.size());
+        cells_.push_back(idx);
+    }
+    const int n_new = size();
+    fields_.resize(n_new);
+    #pragma omp parallel for
+    for (int i = n_old; i < n_new; i++) {
+        const int idx  = cells_[i];
+        const int ix   = idx%nx_;
+        const int iy   = (idx/nx_)%ny_;
+        const int ieta = idx/(nx_*ny_);
+        helpers_->local().compute_derived_fields(
+                tau_, dtau, arena_prev, arena_current, ix, iy, ieta,
+                fields_[i]);
+    }
+}
+
+template class U_derivativeT<Cell_small>;
+template class U_derivativeT<Cell_ideal>;
+template class U_derivative_poolT<Cell_small>;
+template class U_derivative_poolT<Cell_ideal>;
+template class DerivedFieldSliceT<Cell_small>;
+template class DerivedFieldSliceT<Cell_ideal>;
@@ -9,9 +9,33 @@
 #include "data_struct.h"
 #include <string.h>
 #include <iostream>
+#include <memory>
+#include <vector>
 
-class U_derivative {
+//! velocity gradients of one cell entering the viscous RK update
+struct ViscousGradients {
+    double theta = 0.;              //!< expansion rate
+    DumuVec a = {0.};               //!< Du^mu
+    VelocityShearVec sigma = {0.};  //!< sigma^{mu nu}
+    VorticityVec omega = {0.};      //!< kinetic vorticity (projected)
+    DmuMuBoverTVec DmuMuBoverT = {0.};
+};
+
+//! the derivative fields of one cell read by the freeze-out surface and
+//! the Cell_info outputs: the viscous gradients and the other three
+//! vorticity tensors, all in tau-eta coordinates
+struct DerivedFields {
+    ViscousGradients grad;
+    VorticityVec omega_k  = {0.};  //!< kinetic vorticity (no projection)
+    VorticityVec omega_th = {0.};  //!< thermal vorticity
+    VorticityVec omega_T  = {0.};  //!< T-vorticity
+};
+
+template <class Cell>
+class U_derivativeT {
  private:
+     typedef GridT<Cell> Grid;
+
      const InitData &DATA;
      const EOS &eos;
      const double T_tol = 1e-5;
@@ -21,16 +45,41 @@ class U_derivative {
      Mat4x4 dUTsup;
 
  public:
-    U_derivative(const InitData &DATA_in, const EOS &eosIn);
-    void MakedU(const double tau, SCGrid &arena_prev, SCGrid &arena_current,
-                const int ix, const int iy, const int ieta);
+    U_derivativeT(const InitData &DATA_in, const EOS &eosIn);
+    //! dtau is the tau distance between arena_prev and arena_current
+    void MakedU(const double tau, const double dtau, Grid &arena_prev,
+                Grid &arena_current, const int ix, const int iy,
+                const int ieta);
+
+    //! MakedU followed by all the gradients the viscous RK update needs,
+    //! written into grad
+    void compute_viscous_gradients(const double tau, Grid &arena_prev,
+                                   Grid &arena_current, const int ix,
+                                   const int iy, const int ieta,
+                                   ViscousGradients &grad);
+
+    //! the ViscousGradients of the cell from the derivatives of MakedU
+    void viscous_gradients_from_dU(const double tau, Grid &arena_current,
+                                   const int ix, const int iy,
+                                   const int ieta, ViscousGradients &grad);
+
+    //! MakedU followed by all the DerivedFields of the cell
+    void compute_derived_fields(const double tau, const double dtau,
+                                Grid &arena_prev, Grid &arena_current,
+                                const int ix, const int iy, const int ieta,
+                                DerivedFields &fields);
+
+    //! the vorticity tensors, sigma^{mu nu} and D^mu(mu_B/T) of fields
+    //! at space-time rapidity eta in t-z coordinates
+    Cell_aux derived_fields_to_tz(const DerivedFields &fields,
+                                  const double eta);
 
     //! this function returns the expansion rate on the grid
-    double calculate_expansion_rate(double tau, SCGrid &arena,
+    double calculate_expansion_rate(double tau, Grid &arena,
                                     int ieta, int ix, int iy);
 
     //! this function returns Du^\mu
-    void calculate_Du_supmu(const double tau, SCGrid &arena, const int ieta,
+    void calculate_Du_supmu(const double tau, Grid &arena, const int ieta,
                             const int ix, const int iy, DumuVec &a);
 
     //! this function returns the vector D^\mu(\mu_B/T)
@@ -38,36 +87,37 @@ class U_derivative {
 
     //! this function computes the kinetic vorticity
     void calculate_kinetic_vorticity_with_spatial_projector(
-        const double tau, SCGrid &arena,
+        const double tau, Grid &arena,
         const int ieta, const int ix, const int iy, const DumuVec &a_local,
         VorticityVec &omega);
 
     //! this function computes the kinetic vorticity without spatial projection
     void calculate_kinetic_vorticity_no_spatial_projection(
-        const double tau, SCGrid &arena,
+        const double tau, Grid &arena,
         const int ieta, const int ix, const int iy, VorticityVec &omega);
 
     //! this function computes the thermal vorticity
-    void calculate_thermal_vorticity(const double tau, SCGrid &arena,
+    void calculate_thermal_vorticity(const double tau, Grid &arena,
         const int ieta, const int ix, const int iy, VorticityVec &omega);
 
     //! this function computes the T-vorticity
-    void calculate_T_vorticity(const double tau, SCGrid &arena,
+    void calculate_T_vorticity(const double tau, Grid &arena,
         const int ieta, const int ix, const int iy, VorticityVec &omega);
 
     //! This funciton returns the velocity shear tensor sigma^\mu\nu
     void calculate_velocity_shear_tensor(
-        const double tau, SCGrid &arena, const int ieta, const int ix,
+        const double tau, Grid &arena, const int ieta, const int ix,
         const int iy, const DumuVec &a_local, VelocityShearVec &sigma);
 
-    int MakeDSpatial(const double tau, SCGrid &arena, const int ix,
+    int MakeDSpatial(const double tau, Grid &arena, const int ix,
                      const int iy, const int ieta);
-    int MakeDTau(const double tau, const Cell_small *grid_pt_prev,
-                 const Cell_small *grid_pt);
+    int MakeDTau(const double tau, const double dtau,
+                 const Cell *grid_pt_prev, const Cell *grid_pt);
 
     //! This is a shell function to compute all 4 kinds of vorticity tensors
     void compute_vorticity_shell(
-        const double tau, SCGrid &arena_prev, SCGrid &arena_curr,
+        const double tau, const double dtau, Grid &arena_prev,
+        Grid &arena_curr,
         const int ieta, const int ix, const int iy, const double eta,
         VorticityVec &omega_local_k, VorticityVec &omega_local_knoSP,
         VorticityVec &omega_local_th, VorticityVec &omega_local_T,
@@ -82,4 +132,89 @@ class U_derivative {
                     const VelocityShearVec sigma_Mline, const double eta);
 };
 
+typedef U_derivativeT<Cell_small> U_derivative;
+
+//! one U_derivativeT per OpenMP thread, allocated by its own thread (first
+//! touch) and reused for all the cells that thread works on
+template <class Cell>
+class U_derivative_poolT {
+ private:
+    std::vector<std::unique_ptr<U_derivativeT<Cell>>> helpers;
+
+ public:
+    U_derivative_poolT(const InitData &DATA_in, const EOS &eosIn);
+
+    //! the helper of the calling OpenMP thread
+    U_derivativeT<Cell>& local();
+    U_derivativeT<Cell>& operator[](const int thread_id) {
+        return(*helpers[thread_id]);
+    }
+};
+
+//! the DerivedFields of the cells of one time slice, between the states
+//! arena_prev and arena_current at tau, computed once per cell and shared
+//! by the freeze-out surface, the Cell_info outputs and the first RK stage
+//! at tau. Only the cells asked for are stored; the per-cell index is
+//! reset at these cells only.
+template <class Cell>
+class DerivedFieldSliceT {
+ private:
+    typedef GridT<Cell> Grid;
+
+    U_derivative_poolT<Cell> *helpers_;
+    int nx_ = 0;
+    int ny_ = 0;
+    int neta_ = 0;
+    double tau_ = -1.;
+    std::vector<int> index_;   //!< position in fields_ of every cell, or -1
+    std::vector<int> cells_;   //!< the cells stored in fields_
+    std::vector<DerivedFields> fields_;
+
+ public:
+    explicit DerivedFieldSliceT(U_derivative_poolT<Cell> &helpers)
+        : helpers_(&helpers) {}
+
+    double tau() const {return(tau_);}
+    bool fits(const int nx, const int ny, const int neta) const {
+        return(nx == nx_ && ny == ny_ && neta == neta_);
+    }
+    int size() const {return(static_cast<int>(cells_.size()));}
+    int cell_index(const int ix, const int iy, const int ieta) const {
+        return((ieta*ny_ + iy)*nx_ + ix);
+    }
+
+    //! empties the slice for the state at tau of an nx x ny x neta grid
+    void reset(const int nx, const int ny, const int neta, const double tau);
+
+    //! computes the fields of the cells (cell_index) not stored yet
+    void add(const double dtau, Grid &arena_prev, Grid &arena_current,
+             const std::vector<int> &cells);
+    //! add for one cell
+    void add(const double dtau, Grid &arena_prev, Grid &arena_current,
+             const int ix, const int iy, const int ieta) {
+        add(dtau, arena_prev, arena_current,
+            std::vector<int>(1, cell_index(ix, iy, ieta)));
+    }
+
+    //! the fields of the cell, or nullptr if it is not stored
+    const DerivedFields* find(const int ix, const int iy,
+                              const int ieta) const {
+        const int i = index_[cell_index(ix, iy, ieta)];
+        return(i < 0 ? nullptr : &fields_[i]);
+    }
+    const DerivedFields& operator()(const int ix, const int iy,
+                                    const int ieta) const {
+        return(fields_[index_[cell_index(ix, iy, ieta)]]);
+    }
+
+    //! the stored fields of the cell in t-z coordinates at rapidity eta
+    Cell_aux tz(const int ix, const int iy, const int ieta,
+                const double eta) const {
+        return(helpers_->local().derived_fields_to_tz(
+                                        (*this)(ix, iy, ieta), eta));
+    }
+};
+
+typedef DerivedFieldSliceT<Cell_small> DerivedFieldSlice;
+
 #endif
@@ -0,0 +1,39 @@
+#include "eos.h"
+#include "u_derivative.h"
+#include "doctest.h"
+#include <cassert>
+#include <iostream>
+
+
+TEST_CASE("check dmuB/T/dtau with a step other than delta_tau") {
+    // the ideal gas with rhob has muB/T = 5/T^3, which depends on eps and
+    // on rhob
+    EOS eos(0);
+    InitData DATA{};
+    DATA.delta_tau = 0.1;
+    DATA.minmod_theta = 1.8;
+    DATA.include_vorticity_terms = 0;
+    U_derivative helper(DATA, eos);
+
+    Cell_small cell_prev, cell;
+    cell_prev.epsilon = 2.0;
+    cell_prev.rhob    = 0.5;
+    cell.epsilon      = 1.5;
+    cell.rhob         = 0.3;
+    cell_prev.u = {1., 0., 0., 0.};
+    cell.u      = {1., 0., 0., 0.};
+
+    const double dtau = 0.035;
+    helper.MakeDTau(1.0, dtau, &cell_prev, &cell);
+    DmuMuBoverTVec vec;
+    helper.get_DmuMuBoverTVec(vec);
+
+    const double f = (eos.get_muB(cell.epsilon, cell.rhob)
+                      /eos.get_temperature(cell.epsilon, cell.rhob));
+    const double f_prev = (
+        eos.get_muB(cell_prev.epsilon, cell_prev.rhob)
+        /eos.get_temperature(cell_prev.epsilon, cell_prev.rhob));
+    CHECK(f != doctest::Approx(f_prev));
+    // g^{00} = -1
+    CHECK(vec[0] == doctest::Approx(-(f - f_prev)/dtau));
+}
@@ -2,10 +2,18 @@
 // Copyright (C) 2017  Gabriel Denicol, Charles Gale, Sangyong Jeon, Matthew Luzum, Jean-François Paquet, Björn Schenke, Chun Shen
 
 #include "util.h"
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <execinfo.h>
 #include <algorithm>
+#include <vector>
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+#ifdef __linux__
+    #include <sched.h>
+#endif
 
 using std::string;
 
@@ -30,25 +38,31 @@ double gmn(const int a) {
 }
 
 
+//! allocates an n1 x n2 matrix as one contiguous block aligned to a cache
+//! line; the row pointers point into the block, m[0] is the block
 double **mtx_malloc(const int n1, const int n2) {
-    double **d1_ptr; 
-    d1_ptr = new double *[n1];
-
-    for(int i=0; i<n1; i++) 
-        d1_ptr[i] = new double [n2];
+    double **d1_ptr;
+    d1_ptr = new double *[std::max(1, n1)];
+
+    void *block = nullptr;
+    const size_t size = std::max(1, n1*n2)*sizeof(double);
+    if (posix_memalign(&block, 64, size) != 0) {
+        std::cout << "mtx_malloc: can not allocate a " << n1 << " x " << n2
+                  << " matrix" << std::endl;
+        exit(1);
+    }
+    d1_ptr[0] = static_cast<double*>(block);
+    for (int i = 1; i < n1; i++)
+        d1_ptr[i] = d1_ptr[0] + i*n2;
 
-    for(int i=0; i<n1; i++) 
-    for(int j=0; j<n2; j++) 
-        d1_ptr[i][j] = 0.0;
+    std::fill(d1_ptr[0], d1_ptr[0] + n1*n2, 0.0);
 
     return d1_ptr;
 }
 
 
-
 void mtx_free(double **m, const int n1, const int n2) {
-    for (int j = 0; j < n1; j++) 
-        delete [] m[j];
+    free(m[0]);
     delete [] m;
 }
 
@@ -328,4 +342,30 @@ Mat4x4 UnpackVecToMatrix(const VorticityVec &in_vector) {
     return out_matrix;
 }
 
+
+int pin_omp_threads() {
+    int n_pinned = 0;
+#if defined(_OPENMP) && defined(__linux__)
+    // CPUs allowed by taskset, cgroups or the batch system
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return(0);
+    std::vector<int> cpus;
+    for (int icpu = 0; icpu < CPU_SETSIZE; icpu++) {
+        if (CPU_ISSET(icpu, &allowed)) cpus.push_back(icpu);
+    }
+    if (cpus.empty()) return(0);
+
+    #pragma omp parallel reduction(+:n_pinned)
+    {
+        const int ithread = omp_get_thread_num();
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(cpus[ithread % cpus.size()], &mask);
+        // pid 0 is the calling thread
+        if (sched_setaffinity(0, sizeof(mask), &mask) == 0) n_pinned++;
+    }
+#endif
+    return(n_pinned);
+}
+
 }
@@ -53,6 +53,10 @@ namespace Util {
     Mat4x4 UnpackVecToMatrix(const ViscousVec &in_vector);
     Mat4x4 UnpackVecToMatrix(const VorticityVec &in_vector);
 
+    //! binds OpenMP thread i to the i-th CPU the process may run on
+    //! (compact placement); returns the number of threads pinned
+    int pin_omp_threads();
+
     // check whether a weak pointer is initialized or not
     template <typename T>
     bool weak_ptr_is_uninitialized(std::weak_ptr<T> const& weak) {
@@ -16,6 +16,9 @@ control_dict = {
                 #    postprocessing with the stored results
                 # 13: Compute observables from thermal spectra
                 # 14: Compute observables from post-decay spectra
+                # 71: Output the EoS tables for checks
+                # 72: Time the EoS queries at random (e, rhob)
+                # 73: Output the transport coefficients
     'echo_level' : 1,   # switch to control the mount of warning message output
                         # chosen from 1 to 9
 }
@@ -79,6 +82,10 @@ hydro_dict = {
     'Total_evolution_time_tau': 50.,    # the maximum allowed running evolution time (fm/c)
                                         # need to be set to some large enough number
     'Delta_Tau': 0.04,                  # time step to use in the evolution [fm/c]
+    'adaptive_time_step': 0,            # 1: set the time step every step from the CFL condition
+                                        # and the relaxation times (Delta_Tau is the first step)
+    'cfl_number': 0.4,                  # CFL number of the adaptive time step
+    'delta_tau_max': 0.1,               # largest adaptive time step [fm/c]
     'Eta_grid_size': 14.0,              # spatial rapidity range
                                         # [-Eta_grid_size/2, Eta_grid_size/2 - delta_eta]
     'Grid_size_in_eta': 4,              # number of the grid points in spatial rapidity direction
@@ -107,8 +114,21 @@ hydro_dict = {
                       # 10: lattice EOS at finite muB (from A. Monnai)
     'check_eos': 0,   # switch to out check files for EoS
     'Minmod_Theta': 1.8,     # theta parameter in the min-mod like limiter
-    'Runge_Kutta_order': 2,  # order of Runge_Kutta for temporal evolution (must be 1 or 2)
+    'Runge_Kutta_order': 2,  # order of Runge_Kutta for temporal evolution (1, 2 or 3 = SSP-RK3)
     'boost_invariant': 0,    # initial condition is boost invariant
+    'use_SoA_grid_storage': 0,  # stream the stencil kernels from a structure-of-arrays copy of the grid
+    'use_pencil_flux_kernel': 0,  # compute the KT fluxes along whole x-pencils with vectorized limiters
+    'use_face_flux_kernel': 0,    # compute every KT interface flux once per face instead of twice
+    'use_primitive_cache': 0,     # evaluate the EOS once per cell and RK stage for the stencil kernels
+    'omp_thread_affinity': 0,   # pin each OpenMP thread to one CPU (keeps first-touched arena pages local)
+    'use_ghost_cells': 0,       # pad the grid with a 2-cell ghost layer to avoid index clamping in the stencils
+    'brick_size_x': 0,          # cells per brick in x for the cache-blocked RK sweep (0: whole grid)
+    'brick_size_y': 8,          # cells per brick in y for the cache-blocked RK sweep
+    'brick_size_eta': 2,        # cells per brick in eta for the cache-blocked RK sweep
+    'active_region_eps_cut': 0.,  # only evolve the box around cells with e > cut [GeV/fm^3] (0: whole grid)
+    'expanding_grid': 0,        # grow the transverse grid with the fireball (up to Grid_size_in_x/y)
+    'expanding_grid_eps_cut': 1e-3,  # e [GeV/fm^3] marking the edge of the fireball for expanding_grid
+    'expanding_grid_buffer': 10,     # min. number of cells between fireball and grid edge (expanding_grid)
 
     #viscosity and diffusion options
     'Viscosity_Flag_Yes_1_No_0': 1,               # turn on viscosity in the evolution
@@ -117,6 +137,8 @@ hydro_dict = {
     'T_dependent_Shear_to_S_ratio': 0,            # switch to turn on temperature dependent eta/s(T)
     'Include_Bulk_Visc_Yes_1_No_0': 0,            # include bulk viscous effect
     'Include_second_order_terms': 0,              # include second order coupling terms
+    'semi_implicit_relaxation': 0,                # implicit relaxation terms, no 3*Delta_Tau floor on
+                                                  # the relaxation times
     'Include_Rhob_Yes_1_No_0': 0,                 # turn on propagation of baryon current
     'turn_on_baryon_diffusion': 0,                # turn on baryon current diffusion
     'kappa_coefficient': 0.0,                     # constant in the baryon diffusion coefficient